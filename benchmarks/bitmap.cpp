@@ -0,0 +1,195 @@
+/*
+ * Measures the bitmap drawing kernels in isolation and reports
+ * megapixels per second as JSON.
+ *
+ * Usage: benchmark_bitmap [OUTPUT.json]
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "bitmap.h"
+#include "color.h"
+#include "matrix.h"
+#include "pixel_format.h"
+#include "rect.h"
+#include "text.h"
+#include "tone.h"
+#include "utils.h"
+
+namespace {
+
+	/** Border around the destination area, room for the overlap cases. */
+	const int border = 4;
+
+	/** Minimum measuring time of a case. */
+	const uint64_t min_time_ns = 100000000;
+
+	typedef int (*KernelFunction)(Bitmap& dst, Bitmap const& src, int size, int opacity);
+
+	struct Kernel {
+		const char* name;
+		KernelFunction function;
+		/** Whether the kernel takes an opacity */
+		bool opacity;
+		/** Whether source and destination may be the same bitmap */
+		bool overlap;
+	};
+
+	// Every kernel draws a size x size area and returns the drawn pixels
+
+	int Blit(Bitmap& dst, Bitmap const& src, int size, int opacity) {
+		dst.Blit(border, border, src, Rect(0, 0, size, size), opacity);
+		return size * size;
+	}
+
+	int StretchBlit(Bitmap& dst, Bitmap const& src, int size, int opacity) {
+		dst.StretchBlit(Rect(border, border, size, size), src, Rect(0, 0, size / 2, size / 2), opacity);
+		return size * size;
+	}
+
+	int ToneBlit(Bitmap& dst, Bitmap const& src, int size, int /* opacity */) {
+		dst.ToneBlit(border, border, src, Rect(0, 0, size, size), Tone(64, -32, 0, 128));
+		return size * size;
+	}
+
+	int HueChangeBlit(Bitmap& dst, Bitmap const& src, int size, int /* opacity */) {
+		dst.HueChangeBlit(border, border, src, Rect(0, 0, size, size), 90.0);
+		return size * size;
+	}
+
+	int BlendBlit(Bitmap& dst, Bitmap const& src, int size, int /* opacity */) {
+		dst.BlendBlit(border, border, src, Rect(0, 0, size, size), Color(255, 0, 0, 128));
+		return size * size;
+	}
+
+	int FlipBlit(Bitmap& dst, Bitmap const& src, int size, int /* opacity */) {
+		dst.FlipBlit(border, border, src, Rect(0, 0, size, size), true, false);
+		return size * size;
+	}
+
+	int Fill(Bitmap& dst, Bitmap const& /* src */, int size, int /* opacity */) {
+		dst.FillRect(Rect(border, border, size, size), Color(40, 80, 120, 255));
+		return size * size;
+	}
+
+	int TransformBlit(Bitmap& dst, Bitmap const& src, int size, int opacity) {
+		Matrix fwd = Matrix::Setup(0.5, 1.0, 1.0, size / 2, size / 2, border + size / 2, border + size / 2);
+		dst.TransformBlit(Rect(border, border, size, size), src, Rect(0, 0, size, size), fwd.Inverse(), opacity);
+		return size * size;
+	}
+
+	int WaverBlit(Bitmap& dst, Bitmap const& src, int size, int opacity) {
+		dst.WaverBlit(border, border, 1.0, 1.0, src, Rect(0, 0, size, size), 4, 0.5, opacity);
+		return size * size;
+	}
+
+	int TextDraw(Bitmap& dst, Bitmap const& /* src */, int size, int /* opacity */) {
+		// Fill the area with half width glyphs (6x12)
+		std::string line(std::max(size / 6, 1), 'A');
+		std::string text = line;
+		for (int i = 1; i < size / 12; ++i) {
+			text += "\n" + line;
+		}
+		Text::Draw(dst, border, border, Color(255, 255, 255, 255), text);
+		return (int)line.size() * 6 * std::max(size / 12, 1) * 12;
+	}
+
+	const Kernel kernels[] = {
+		{ "Blit", Blit, true, true },
+		{ "StretchBlit", StretchBlit, true, false },
+		{ "ToneBlit", ToneBlit, false, true },
+		{ "HueChangeBlit", HueChangeBlit, false, true },
+		{ "BlendBlit", BlendBlit, false, true },
+		{ "FlipBlit", FlipBlit, false, true },
+		{ "Fill", Fill, false, false },
+		{ "TransformBlit", TransformBlit, true, false },
+		{ "WaverBlit", WaverBlit, true, false },
+		{ "TextDraw", TextDraw, false, false }
+	};
+
+	const int sizes[] = { 16, 64, 320 };
+
+	const int opacities[] = { 255, 128 };
+
+	struct Format {
+		const char* name;
+		DynamicFormat format;
+	};
+
+	BitmapRef CreateSource(int size) {
+		BitmapRef bitmap = Bitmap::Create(size + 2 * border, size + 2 * border, true);
+		bitmap->Fill(Color(40, 120, 200, 255));
+		// Translucent stripes, so alpha blending has work to do
+		for (int y = 0; y < bitmap->height(); y += 8) {
+			bitmap->FillRect(Rect(0, y, bitmap->width(), 4), Color(200, 60, 30, 128));
+		}
+		return bitmap;
+	}
+
+	double Measure(const Kernel& kernel, int size, int opacity, bool overlap) {
+		BitmapRef dst = CreateSource(size);
+		BitmapRef src = overlap ? dst : CreateSource(size);
+
+		// Warm up caches and lazy initialization
+		kernel.function(*dst, *src, size, opacity);
+
+		uint64_t pixels = 0;
+		uint64_t const start = Utils::GetTimeNs();
+		uint64_t elapsed;
+		do {
+			for (int i = 0; i < 16; ++i) {
+				pixels += kernel.function(*dst, *src, size, opacity);
+			}
+			elapsed = Utils::GetTimeNs() - start;
+		} while (elapsed < min_time_ns);
+
+		return pixels * 1000.0 / elapsed;
+	}
+
+}
+
+int main(int argc, char* argv[]) {
+	const Format formats[] = {
+		{ "B8G8R8A8", format_B8G8R8A8_a().format() },
+		{ "R8G8B8A8", format_R8G8B8A8_a().format() },
+		{ "A1R5G5B5", DynamicFormat(16,5,10,5,5,5,0,1,15,PF::Alpha) }
+	};
+
+	FILE* out = argc > 1 ? fopen(argv[1], "w") : stdout;
+	if (!out) {
+		fprintf(stderr, "Cannot write %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	fprintf(out, "{\n  \"kernels\": [\n");
+	bool first = true;
+	for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); ++f) {
+		Bitmap::SetFormat(formats[f].format);
+
+		for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+			const Kernel& kernel = kernels[k];
+			for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+				int const opacity_count = kernel.opacity ? sizeof(opacities) / sizeof(opacities[0]) : 1;
+				for (int o = 0; o < opacity_count; ++o) {
+					for (int overlap = 0; overlap <= (kernel.overlap ? 1 : 0); ++overlap) {
+						double const mpixels = Measure(kernel, sizes[s], opacities[o], overlap != 0);
+
+						fprintf(out, "%s    {\"kernel\": \"%s\", \"format\": \"%s\", \"size\": %d, \"opacity\": %d, \"overlap\": %s, \"mpixels_per_s\": %.2f}",
+							first ? "" : ",\n", kernel.name, formats[f].name, sizes[s], opacities[o],
+							overlap ? "true" : "false", mpixels);
+						first = false;
+					}
+				}
+			}
+		}
+	}
+	fprintf(out, "\n  ]\n}\n");
+
+	if (out != stdout) {
+		fclose(out);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,254 @@
+/*
+ * Boots the game in the working directory headlessly, plays scripted
+ * scenarios and reports the time of every frame as JSON.
+ *
+ * Usage: benchmark_scenes [OUTPUT.json] [player options...]
+ * Player options like --start-map-id select the map of the scenarios.
+ * Exits with a failure status when a scenario could not run all frames.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "data.h"
+#include "game_message.h"
+#include "game_temp.h"
+#include "graphics.h"
+#include "input.h"
+#include "player.h"
+#include "scene.h"
+#include "utils.h"
+
+namespace {
+
+	typedef void (*ScriptFunction)(int frame);
+
+	struct Scenario {
+		const char* name;
+		/** Called once on the map before the measurement */
+		void (*setup)();
+		/** Presses the buttons of a frame */
+		ScriptFunction script;
+		int frames;
+	};
+
+	struct Result {
+		std::string name;
+		std::vector<double> frame_ms;
+		/** Whether all frames of the scenario ran */
+		bool completed;
+	};
+
+	// Upper bound for boot and for returning to the map between scenarios
+	const int max_wait_frames = 3000;
+
+	/** Set when the game quit, MainLoop called Player::Exit then */
+	bool game_quit = false;
+
+	bool RunFrame() {
+		if (game_quit) {
+			return false;
+		}
+
+		Player::MainLoop();
+		game_quit = !Graphics::IsTransitionPending() && Scene::instance->type == Scene::Null;
+		return true;
+	}
+
+	bool WaitForMap() {
+		for (int i = 0; i < max_wait_frames; ++i) {
+			bool const on_map = Scene::instance->type == Scene::Map && !Graphics::IsTransitionPending();
+			if (!RunFrame()) {
+				return false;
+			}
+			if (on_map) {
+				// The frame above ran Scene_Map::Resume, which clears battle_calling
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void NoSetup() {
+	}
+
+	void WalkScript(int frame) {
+		static const Input::InputButton dirs[] = {
+			Input::DOWN, Input::RIGHT, Input::UP, Input::LEFT
+		};
+		Input::SimulateButtonPress(dirs[frame / 48 % 4]);
+	}
+
+	void MessageScript(int frame) {
+		if (!Game_Message::visible && !Game_Message::message_waiting) {
+			Game_Message::texts.push_back("The quick brown fox jumps over the lazy dog.");
+			Game_Message::texts.push_back("Pack my box with five dozen liquor jugs.");
+			Game_Message::texts.push_back("How vexingly quick daft zebras jump!");
+			Game_Message::texts.push_back("Sphinx of black quartz, judge my vow.");
+			Game_Message::message_waiting = true;
+			Game_Message::owner_id = 0;
+		}
+		if (frame % 30 == 29) {
+			Input::SimulateButtonPress(Input::DECISION);
+		}
+	}
+
+	void MenuSetup() {
+		Input::SimulateButtonPress(Input::CANCEL);
+	}
+
+	void MenuScript(int frame) {
+		if (frame % 8 == 0) {
+			Input::SimulateButtonPress(frame / 64 % 2 ? Input::UP : Input::DOWN);
+		}
+	}
+
+	void TransitionScript(int frame) {
+		// Opens and closes the menu
+		if (frame % 40 == 0) {
+			Input::SimulateButtonPress(Input::CANCEL);
+		}
+	}
+
+	void BattleSetup() {
+		Game_Temp::battle_troop_id = 1;
+		Game_Temp::battle_terrain_id = 1;
+		Game_Temp::battle_background = Data::system.battletest_background;
+		Game_Temp::battle_escape_mode = -1;
+		// Continue instead of game over
+		Game_Temp::battle_defeat_mode = 1;
+		Game_Temp::battle_first_strike = false;
+		Game_Temp::battle_mode = 0;
+		Game_Temp::battle_result = Game_Temp::BattleVictory;
+		Game_Temp::battle_calling = true;
+	}
+
+	void BattleScript(int frame) {
+		// Always the first command and target: fight and attack
+		if (frame % 15 == 0) {
+			Input::SimulateButtonPress(Input::DECISION);
+		}
+	}
+
+	const Scenario scenarios[] = {
+		{ "map_walk", NoSetup, WalkScript, 1200 },
+		{ "messages", NoSetup, MessageScript, 1200 },
+		{ "menu", MenuSetup, MenuScript, 600 },
+		{ "transitions", NoSetup, TransitionScript, 1200 },
+		{ "battle", BattleSetup, BattleScript, 1800 }
+	};
+
+	Result Run(const Scenario& scenario) {
+		Result result;
+		result.name = scenario.name;
+		result.frame_ms.reserve(scenario.frames);
+		result.completed = false;
+
+		if (!WaitForMap()) {
+			fprintf(stderr, "%s: map scene not reached\n", scenario.name);
+			return result;
+		}
+
+		scenario.setup();
+		for (int frame = 0; frame < scenario.frames; ++frame) {
+			scenario.script(frame);
+			uint64_t const start = Utils::GetTimeNs();
+			if (!RunFrame()) {
+				fprintf(stderr, "%s: game quit after %d frames\n", scenario.name, frame);
+				return result;
+			}
+			result.frame_ms.push_back((Utils::GetTimeNs() - start) / 1000000.0);
+		}
+		result.completed = true;
+
+		// Leave menus and messages for the next scenario
+		Game_Message::texts.clear();
+		Game_Message::message_waiting = false;
+		for (int i = 0; i < 8 && !game_quit && Scene::instance->type != Scene::Map; ++i) {
+			Input::SimulateButtonPress(Input::CANCEL);
+			for (int e = 0; e < 30; ++e) {
+				if (!RunFrame()) {
+					break;
+				}
+			}
+		}
+
+		return result;
+	}
+
+	double Percentile(const std::vector<double>& sorted, double percent) {
+		size_t index = (size_t)(percent / 100.0 * (sorted.size() - 1) + 0.5);
+		return sorted[index];
+	}
+
+	void WriteJson(FILE* out, const std::vector<Result>& results) {
+		fprintf(out, "{\n  \"scenarios\": [\n");
+		for (size_t i = 0; i < results.size(); ++i) {
+			std::vector<double> sorted = results[i].frame_ms;
+			std::sort(sorted.begin(), sorted.end());
+
+			fprintf(out, "    {\"name\": \"%s\", \"frames\": %d", results[i].name.c_str(), (int)sorted.size());
+			if (!sorted.empty()) {
+				double sum = 0.0;
+				for (size_t e = 0; e < sorted.size(); ++e) {
+					sum += sorted[e];
+				}
+				fprintf(out, ", \"mean_ms\": %.4f, \"p50_ms\": %.4f, \"p90_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f",
+					sum / sorted.size(), Percentile(sorted, 50), Percentile(sorted, 90),
+					Percentile(sorted, 99), sorted.back());
+			}
+			fprintf(out, "}%s\n", i + 1 < results.size() ? "," : "");
+		}
+		fprintf(out, "  ]\n}\n");
+	}
+
+}
+
+int main(int argc, char* argv[]) {
+	std::string output;
+	int first_arg = 1;
+	if (argc > 1 && argv[1][0] != '-') {
+		output = argv[1];
+		first_arg = 2;
+	}
+
+	// No window, no frame limit and straight to the map
+	std::vector<char*> args;
+	args.push_back(argv[0]);
+	args.push_back(const_cast<char*>("--headless"));
+	args.push_back(const_cast<char*>("--turbo"));
+	args.push_back(const_cast<char*>("1"));
+	args.push_back(const_cast<char*>("--new-game"));
+	args.push_back(const_cast<char*>("--seed"));
+	args.push_back(const_cast<char*>("1"));
+	for (int i = first_arg; i < argc; ++i) {
+		args.push_back(argv[i]);
+	}
+	Player::Init((int)args.size(), &args[0]);
+
+	Player::Start();
+
+	std::vector<Result> results;
+	bool completed = true;
+	for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); ++i) {
+		results.push_back(Run(scenarios[i]));
+		completed = completed && results.back().completed;
+	}
+
+	FILE* out = output.empty() ? stdout : fopen(output.c_str(), "w");
+	if (!out) {
+		fprintf(stderr, "Cannot write %s\n", output.c_str());
+		return EXIT_FAILURE;
+	}
+	WriteJson(out, results);
+	if (out != stdout) {
+		fclose(out);
+	}
+
+	if (!game_quit) {
+		Player::Exit();
+	}
+	return completed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -15,21 +15,29 @@
  * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstdio>
 #include <cstdlib>
+#include <deque>
 #include <map>
 #include "async_handler.h"
 #include "filefinder.h"
 #include "memory_management.h"
 #include "output.h"
 #include "player.h"
+#include "trace.h"
 
 #ifdef EMSCRIPTEN
 #include <emscripten.h>
+#else
+#include <SDL.h>
+#include <SDL_thread.h>
 #endif
 
 namespace {
 	std::map<std::string, FileRequestAsync> async_requests;
 	int next_id = 0;
+	/** Number of requests with important-flag that are not ready yet */
+	int important_pending = 0;
 
 	FileRequestAsync* GetRequest(const std::string& path) {
 		std::map<std::string, FileRequestAsync>::iterator it = async_requests.find(path);
@@ -44,6 +52,92 @@ namespace {
 		async_requests[path] = request;
 	}
 
+#ifndef EMSCRIPTEN
+	/** File read performed by a worker thread. */
+	struct ReadJob {
+		/** Path of the request in async_requests */
+		std::string request_path;
+		/** Path of the file, resolved by FileFinder */
+		std::string file_path;
+		std::vector<uint8_t> data;
+	};
+
+	std::vector<SDL_Thread*> workers;
+	SDL_mutex* job_mutex = NULL;
+	SDL_cond* job_cond = NULL;
+	/** Protected by job_mutex */
+	std::deque<ReadJob*> pending_jobs;
+	std::deque<ReadJob*> finished_jobs;
+	bool workers_quit = false;
+
+	/** Job whose event handlers are running, see GetPreloadedData */
+	const ReadJob* delivered_job = NULL;
+
+	/** Only images are read from preloaded data, by Cache::LoadBitmap */
+	bool IsImageFolder(const std::string& folder_name) {
+		return folder_name != "Music" && folder_name != "Sound" && folder_name != ".";
+	}
+
+	void ReadFile(ReadJob& job) {
+		// Runs on the worker, must not use Output or the FileFinder caches
+		TRACE_SCOPE("file", "AsyncHandler::ReadFile");
+
+		FILE* stream = FileFinder::fopenUTF8(job.file_path, "rb");
+		if (!stream) {
+			return;
+		}
+
+		char buffer[64 * 1024];
+		size_t bytes;
+		while ((bytes = fread(buffer, 1, sizeof(buffer), stream)) > 0) {
+			job.data.insert(job.data.end(), buffer, buffer + bytes);
+		}
+
+		fclose(stream);
+	}
+
+	int WorkerMain(void*) {
+		SDL_LockMutex(job_mutex);
+		for (;;) {
+			while (pending_jobs.empty() && !workers_quit) {
+				SDL_CondWait(job_cond, job_mutex);
+			}
+			if (workers_quit) {
+				break;
+			}
+
+			ReadJob* job = pending_jobs.front();
+			pending_jobs.pop_front();
+
+			SDL_UnlockMutex(job_mutex);
+			ReadFile(*job);
+			SDL_LockMutex(job_mutex);
+
+			finished_jobs.push_back(job);
+		}
+		SDL_UnlockMutex(job_mutex);
+
+		return 0;
+	}
+
+	bool QueueRead(const std::string& request_path, const std::string& file_path) {
+		if (workers.empty() || file_path.empty()) {
+			return false;
+		}
+
+		ReadJob* job = new ReadJob();
+		job->request_path = request_path;
+		job->file_path = file_path;
+
+		SDL_LockMutex(job_mutex);
+		pending_jobs.push_back(job);
+		SDL_CondSignal(job_cond);
+		SDL_UnlockMutex(job_mutex);
+
+		return true;
+	}
+#endif
+
 #ifdef EMSCRIPTEN
 	void download_success(unsigned, void* userData, const char*) {
 		FileRequestAsync* req = static_cast<FileRequestAsync*>(userData);
@@ -81,19 +175,102 @@ FileRequestAsync* AsyncHandler::RequestFile(const std::string& file_name) {
 }
 
 bool AsyncHandler::IsImportantFilePending() {
-	std::map<std::string, FileRequestAsync>::iterator it;
+	// Maintained by SetImportantFile and DownloadDone.
+	// For fake download testing call UpdateProgress on all requests here.
+	return important_pending > 0;
+}
 
-	for (it = async_requests.begin(); it != async_requests.end(); ++it) {
-		FileRequestAsync& request = it->second;
-		// remove comment for fake download testing
-		//request.UpdateProgress();
+void AsyncHandler::SetWorkerThreads(int count) {
+#ifndef EMSCRIPTEN
+	Quit();
 
-		if (!request.IsReady() && request.IsImportantFile()) {
-			return true;
+	if (count <= 0) {
+		return;
+	}
+
+	job_mutex = SDL_CreateMutex();
+	job_cond = SDL_CreateCond();
+	workers_quit = false;
+
+	for (int i = 0; i < count; ++i) {
+#if SDL_MAJOR_VERSION==1
+		SDL_Thread* thread = SDL_CreateThread(&WorkerMain, NULL);
+#else
+		SDL_Thread* thread = SDL_CreateThread(&WorkerMain, "AsyncHandler", NULL);
+#endif
+		if (!thread) {
+			Output::Warning("Couldn't create file loading thread: %s", SDL_GetError());
+			break;
 		}
+		workers.push_back(thread);
 	}
 
-	return false;
+	Output::Debug("Reading files on %d worker threads", (int)workers.size());
+#endif
+}
+
+void AsyncHandler::Update() {
+#ifndef EMSCRIPTEN
+	if (workers.empty()) {
+		return;
+	}
+
+	std::deque<ReadJob*> jobs;
+	SDL_LockMutex(job_mutex);
+	jobs.swap(finished_jobs);
+	SDL_UnlockMutex(job_mutex);
+
+	for (std::deque<ReadJob*>::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+		FileRequestAsync* request = GetRequest((*it)->request_path);
+		if (request) {
+			delivered_job = *it;
+			request->DownloadDone(true);
+			delivered_job = NULL;
+		}
+		delete *it;
+	}
+#endif
+}
+
+void AsyncHandler::Quit() {
+#ifndef EMSCRIPTEN
+	if (workers.empty()) {
+		return;
+	}
+
+	SDL_LockMutex(job_mutex);
+	workers_quit = true;
+	SDL_CondBroadcast(job_cond);
+	SDL_UnlockMutex(job_mutex);
+
+	for (size_t i = 0; i < workers.size(); ++i) {
+		SDL_WaitThread(workers[i], NULL);
+	}
+	workers.clear();
+
+	for (size_t i = 0; i < pending_jobs.size(); ++i) {
+		delete pending_jobs[i];
+	}
+	pending_jobs.clear();
+	for (size_t i = 0; i < finished_jobs.size(); ++i) {
+		delete finished_jobs[i];
+	}
+	finished_jobs.clear();
+
+	SDL_DestroyCond(job_cond);
+	job_cond = NULL;
+	SDL_DestroyMutex(job_mutex);
+	job_mutex = NULL;
+#endif
+}
+
+const std::vector<uint8_t>* AsyncHandler::GetPreloadedData(const std::string& path) {
+#ifndef EMSCRIPTEN
+	if (delivered_job && !delivered_job->data.empty() && delivered_job->file_path == path) {
+		return &delivered_job->data;
+	}
+#endif
+	return NULL;
 }
 
 FileRequestAsync::FileRequestAsync(const std::string& folder_name, const std::string& file_name) :
@@ -105,7 +282,9 @@ FileRequestAsync::FileRequestAsync(const std::string& folder_name, const std::st
 	state = State_WaitForStart;
 }
 
-FileRequestAsync::FileRequestAsync() {
+FileRequestAsync::FileRequestAsync() :
+	state(State_WaitForStart),
+	important(false) {
 }
 
 bool FileRequestAsync::IsReady() const {
@@ -117,6 +296,10 @@ bool FileRequestAsync::IsImportantFile() const {
 }
 
 void FileRequestAsync::SetImportantFile(bool important) {
+	if (!IsReady() && important != this->important) {
+		important_pending += important ? 1 : -1;
+	}
+
 	this->important = important;
 }
 
@@ -149,6 +332,11 @@ void FileRequestAsync::Start() {
 		download_failure,
 		NULL);
 #else
+	// Read images on a worker thread, the handlers are called by AsyncHandler::Update
+	if (IsImageFolder(directory) && QueueRead(path, FileFinder::FindImage(directory, file))) {
+		return;
+	}
+
 	// add comment for fake download testing
 	DownloadDone(true);
 #endif
@@ -211,6 +399,8 @@ void FileRequestAsync::DownloadDone(bool success) {
 	if (IsReady()) {
 		// Change to real success state when already finished before
 		success = state == State_DoneSuccess;
+	} else if (important) {
+		--important_pending;
 	}
 
 	if (success) {
@@ -21,6 +21,7 @@
 #include <boost/function.hpp>
 #include <string>
 #include <vector>
+#include "system.h"
 
 class FileRequestAsync;
 struct FileRequestResult;
@@ -57,10 +58,40 @@ namespace AsyncHandler {
 
 	/**
 	 * Checks if any file with important-flag hasn't finished downloading yet.
+	 * This is a counter lookup and cheap enough to be called every frame.
 	 *
 	 * @return If any file with important-flag is pending.
 	 */
 	bool IsImportantFilePending();
+
+	/**
+	 * Sets the number of worker threads reading requested images in the
+	 * background. With 0 threads (the default) and for other files requests
+	 * finish immediately in Start. Has no effect on Emscripten.
+	 *
+	 * @param count number of worker threads.
+	 */
+	void SetWorkerThreads(int count);
+
+	/**
+	 * Calls the event handlers of requests the worker threads finished.
+	 * Must be called once per frame from the main thread.
+	 */
+	void Update();
+
+	/**
+	 * Stops the worker threads. Pending requests are dropped.
+	 */
+	void Quit();
+
+	/**
+	 * Gets the content of a file read by a worker thread.
+	 * Only available while the event handlers of the request run.
+	 *
+	 * @param path path of the file, as returned by FileFinder.
+	 * @return file content or NULL when the file was not preloaded.
+	 */
+	const std::vector<uint8_t>* GetPreloadedData(const std::string& path);
 }
 
 /**
@@ -18,6 +18,7 @@
 // Headers
 #include "baseui.h"
 #include "bitmap.h"
+#include "null_ui.h"
 
 #ifdef USE_SDL
 #include "sdl_ui.h"
@@ -25,7 +26,11 @@
 
 EASYRPG_SHARED_PTR<BaseUi> DisplayUi;
 
-EASYRPG_SHARED_PTR<BaseUi> BaseUi::CreateUi(long width, long height, const std::string& title, bool fs_flag, bool /* zoom */) {
+EASYRPG_SHARED_PTR<BaseUi> BaseUi::CreateUi(long width, long height, const std::string& title, bool fs_flag, bool /* zoom */, bool headless) {
+	if (headless) {
+		return EASYRPG_MAKE_SHARED<NullUi>(width, height);
+	}
+
 #ifdef USE_SDL
 	return EASYRPG_MAKE_SHARED<SdlUi>(width, height, title, fs_flag);
 #else
@@ -48,8 +48,9 @@ public:
 	 * @param title display title.
 	 * @param fullscreen start in fullscreen flag.
 	 * @param zoom start with zoom flag.
+	 * @param headless create a NullUi without display, input and audio.
 	 */
-	static EASYRPG_SHARED_PTR<BaseUi> CreateUi(long width, long height, const std::string& title, bool fullscreen, bool zoom);
+	static EASYRPG_SHARED_PTR<BaseUi> CreateUi(long width, long height, const std::string& title, bool fullscreen, bool zoom, bool headless = false);
 
 	/**
 	 * Begins a display mode change.
@@ -33,6 +33,7 @@
 #include "image_bmp.h"
 #include "image_png.h"
 #include "font.h"
+#include "graphics.h"
 #include "output.h"
 #include "util_macro.h"
 #include "bitmap_hslrgb.h"
@@ -57,9 +58,27 @@ BitmapRef Bitmap::Create(Bitmap const& source, Rect const& src_rect, bool transp
 	return EASYRPG_MAKE_SHARED<Bitmap>(source, src_rect, transparent);
 }
 
+static Bitmap::MemoryStats memory_stats[Bitmap::MemoryCategoryCount];
+static Bitmap::MemoryCategory current_memory_category = Bitmap::MemoryOther;
+
+static void AddMemory(Bitmap::MemoryCategory category, size_t bytes) {
+	Bitmap::MemoryStats& stats = memory_stats[category];
+	stats.live_bytes += bytes;
+	stats.peak_bytes = std::max(stats.peak_bytes, stats.live_bytes);
+	++stats.live_count;
+}
+
+static void RemoveMemory(Bitmap::MemoryCategory category, size_t bytes) {
+	Bitmap::MemoryStats& stats = memory_stats[category];
+	stats.live_bytes -= bytes;
+	--stats.live_count;
+}
+
 void Bitmap::InitBitmap() {
 	editing = false;
 	font = Font::Default();
+	memory_category = MemoryOther;
+	memory_bytes = 0;
 }
 
 Bitmap::Bitmap() {
@@ -67,9 +86,52 @@ Bitmap::Bitmap() {
 }
 
 Bitmap::~Bitmap() {
+	if (memory_bytes > 0) {
+		RemoveMemory(memory_category, memory_bytes);
+	}
 	pixman_image_unref(bitmap);
 }
 
+Bitmap::MemoryScope::MemoryScope(MemoryCategory category) :
+	previous(current_memory_category) {
+	current_memory_category = category;
+}
+
+Bitmap::MemoryScope::~MemoryScope() {
+	current_memory_category = previous;
+}
+
+void Bitmap::SetMemoryCategory(MemoryCategory category) {
+	if (memory_bytes > 0) {
+		RemoveMemory(memory_category, memory_bytes);
+		AddMemory(category, memory_bytes);
+	}
+	memory_category = category;
+}
+
+Bitmap::MemoryStats Bitmap::GetMemoryStats(MemoryCategory category) {
+	return memory_stats[category];
+}
+
+const char* Bitmap::GetMemoryCategoryName(MemoryCategory category) {
+	static const char* const names[MemoryCategoryCount] = {
+		"Other", "Cache", "Tiles", "Sprite", "Window", "Tilemap", "Font"
+	};
+	return names[category];
+}
+
+void Bitmap::DumpMemoryStats() {
+	size_t total = 0;
+	for (int i = 0; i < MemoryCategoryCount; ++i) {
+		const MemoryStats& stats = memory_stats[i];
+		Output::Debug("Bitmap memory %-7s %6d KB live (%d bitmaps), %6d KB peak, %d created",
+			GetMemoryCategoryName((MemoryCategory)i), (int)(stats.live_bytes / 1024), stats.live_count,
+			(int)(stats.peak_bytes / 1024), stats.allocations);
+		total += stats.live_bytes;
+	}
+	Output::Debug("Bitmap memory total %d KB live", (int)(total / 1024));
+}
+
 bool Bitmap::WritePNG(std::ostream& os) const {
 	size_t const width = GetWidth(), height = GetHeight();
 	size_t const stride = width * 4;
@@ -462,6 +524,18 @@ void Bitmap::Init(int width, int height, void* data, int pitch, bool destroy) {
 
 	if (data != NULL && destroy)
 		pixman_image_set_destroy_function(bitmap, destroy_func, data);
+
+	// Pixels passed without destroy belong to the caller, e.g. the display surface
+	memory_category = current_memory_category;
+	++memory_stats[memory_category].allocations;
+	if (data == NULL || destroy) {
+		memory_bytes = (size_t)pixman_image_get_stride(bitmap) * height;
+		AddMemory(memory_category, memory_bytes);
+	}
+
+	if (Graphics::profiler_on_screen) {
+		++Graphics::frame_counters.bitmaps_created;
+	}
 }
 
 void Bitmap::ConvertImage(int& width, int& height, void*& pixels, bool transparent) {
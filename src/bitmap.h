@@ -686,6 +686,76 @@ public:
 	static DynamicFormat image_format;
 	static DynamicFormat opaque_image_format;
 
+	/** Owners of bitmap memory in the memory statistic. */
+	enum MemoryCategory {
+		MemoryOther,
+		/** Images loaded by Cache */
+		MemoryCache,
+		/** Chipset tiles of Cache::Tile */
+		MemoryTiles,
+		/** Tone, flash and flip buffers of sprites */
+		MemorySprite,
+		/** Window skin parts and contents */
+		MemoryWindow,
+		/** Generated autotiles of the tilemap */
+		MemoryTilemap,
+		/** Rendered glyphs */
+		MemoryFont,
+		MemoryCategoryCount
+	};
+
+	/** Memory statistic of a category. */
+	struct MemoryStats {
+		MemoryStats() : live_bytes(0), peak_bytes(0), live_count(0), allocations(0) {}
+
+		size_t live_bytes;
+		/** Highest live_bytes since start */
+		size_t peak_bytes;
+		int live_count;
+		/** Bitmaps created since start */
+		int allocations;
+	};
+
+	/**
+	 * Tags the bitmaps created during its lifetime with a category.
+	 * Scopes nest, the innermost one wins.
+	 */
+	class MemoryScope {
+	public:
+		explicit MemoryScope(MemoryCategory category);
+		~MemoryScope();
+
+	private:
+		MemoryCategory previous;
+	};
+
+	/**
+	 * Moves the bitmap to another category, for bitmaps whose owner is
+	 * only known after creation.
+	 *
+	 * @param category new category.
+	 */
+	void SetMemoryCategory(MemoryCategory category);
+
+	/**
+	 * Gets the memory statistic of a category.
+	 *
+	 * @param category memory category.
+	 * @return statistic.
+	 */
+	static MemoryStats GetMemoryStats(MemoryCategory category);
+
+	/**
+	 * @param category memory category.
+	 * @return name of the category.
+	 */
+	static const char* GetMemoryCategoryName(MemoryCategory category);
+
+	/**
+	 * Writes the memory statistic of all categories to the log.
+	 */
+	static void DumpMemoryStats();
+
 	void* pixels();
 	void const* pixels() const;
 	int width() const;
@@ -698,6 +768,10 @@ protected:
 	pixman_image_t *bitmap;
 	pixman_format_code_t pixman_format;
 
+	/** Accounted pixel memory, 0 for pixels owned by someone else. */
+	MemoryCategory memory_category;
+	size_t memory_bytes;
+
 	void Init(int width, int height, void* data, int pitch = 0, bool destroy = true);
 
 	void ReadPNG(FILE* stream, const void *data);
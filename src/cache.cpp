@@ -30,8 +30,10 @@
 #include "filefinder.h"
 #include "exfont.h"
 #include "bitmap.h"
+#include "graphics.h"
 #include "output.h"
 #include "player.h"
+#include "trace.h"
 #include "data.h"
 
 namespace {
@@ -46,19 +48,36 @@ namespace {
 
 	static std::string system_name;
 
+	void CountLookup(bool hit) {
+		if (Graphics::profiler_on_screen) {
+			++(hit ? Graphics::frame_counters.cache_hits : Graphics::frame_counters.cache_misses);
+		}
+	}
+
 	BitmapRef LoadBitmap(std::string const& folder_name, const std::string& filename,
 						 bool transparent, uint32_t const flags) {
 		string_pair const key(folder_name, filename);
 
 		cache_type::const_iterator const it = cache.find(key);
+		bool const hit = it != cache.end() && !it->second.expired();
+		CountLookup(hit);
+
+		if (!hit) {
+			TRACE_SCOPE("cache", "Cache::LoadBitmap miss");
+			Bitmap::MemoryScope memory_scope(Bitmap::MemoryCache);
 
-		if (it == cache.end() || it->second.expired()) {
 			std::string const path = FileFinder::FindImage(folder_name, filename);
 
 			if (path.empty()) {
 				return BitmapRef();
 			}
 
+			// Already read by an AsyncHandler worker thread?
+			const std::vector<uint8_t>* data = AsyncHandler::GetPreloadedData(path);
+			if (data) {
+				return (cache[key] = Bitmap::Create(&(*data)[0], data->size(), transparent, flags)).lock();
+			}
+
 			return (cache[key] = Bitmap::Create(path, transparent, flags)).lock();
 		} else { return it->second.lock(); }
 	}
@@ -119,6 +138,7 @@ namespace {
 
 		string_pair const key(folder_name, filename);
 
+		Bitmap::MemoryScope memory_scope(Bitmap::MemoryCache);
 		BitmapRef bitmap = Bitmap::Create(s.max_width, s.max_height, false);
 
 		// ToDo: Maybe use different renderers depending on material
@@ -197,8 +217,11 @@ BitmapRef Cache::Exfont() {
 	string_pair const hash("\x00","ExFont");
 
 	cache_type::const_iterator const it = cache.find(hash);
+	bool const hit = it != cache.end() && !it->second.expired();
+	CountLookup(hit);
 
-	if (it == cache.end() || it->second.expired()) {
+	if (!hit) {
+		Bitmap::MemoryScope memory_scope(Bitmap::MemoryCache);
 		return(cache[hash] = Bitmap::Create(exfont_h, sizeof(exfont_h), true)).lock();
 	} else { return it->second.lock(); }
 }
@@ -206,8 +229,10 @@ BitmapRef Cache::Exfont() {
 BitmapRef Cache::Tile(const std::string& filename, int tile_id) {
 	tile_pair const key(filename, tile_id);
 	cache_tiles_type::const_iterator const it = cache_tiles.find(key);
+	bool const hit = it != cache_tiles.end() && !it->second.expired();
+	CountLookup(hit);
 
-	if (it == cache_tiles.end() || it->second.expired()) {
+	if (!hit) {
 		BitmapRef chipset = Cache::Chipset(filename);
 		Rect rect = Rect(0, 0, 16, 16);
 
@@ -232,6 +257,7 @@ BitmapRef Cache::Tile(const std::string& filename, int tile_id) {
 		rect.x += sub_tile_id % 6 * 16;
 		rect.y += sub_tile_id / 6 * 16;
 
+		Bitmap::MemoryScope memory_scope(Bitmap::MemoryTiles);
 		return(cache_tiles[key] = Bitmap::Create(*chipset, rect)).lock();
 	} else { return it->second.lock(); }
 }
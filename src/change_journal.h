@@ -0,0 +1,137 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _CHANGE_JOURNAL_H_
+#define _CHANGE_JOURNAL_H_
+
+// Headers
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+/**
+ * Records the changes of an ID indexed value array (switches, variables).
+ * Tracks the IDs changed since the last ClearChanged in a dirty bitset and,
+ * when a journal size is set, the latest changes with old and new value.
+ */
+template <typename T>
+class ChangeJournal {
+public:
+	/** A single change. */
+	struct Entry {
+		int id;
+		T old_value;
+		T new_value;
+		/** Value of Player::GetFrames at the time of the change. */
+		int frame;
+	};
+
+	ChangeJournal() : journal_size(0) {}
+
+	/**
+	 * Records a change.
+	 *
+	 * @param id changed ID.
+	 * @param old_value value before the change.
+	 * @param new_value value after the change.
+	 * @param frame current frame.
+	 */
+	void Record(int id, T old_value, T new_value, int frame) {
+		if (id >= (int)dirty.size()) {
+			dirty.resize(id + 1);
+		}
+		if (!dirty[id]) {
+			dirty[id] = true;
+			changed.push_back(id);
+		}
+
+		if (journal_size > 0) {
+			if (journal.size() >= journal_size) {
+				journal.pop_front();
+			}
+			Entry entry = { id, old_value, new_value, frame };
+			journal.push_back(entry);
+		}
+	}
+
+	/**
+	 * Checks whether an ID changed since the last ClearChanged.
+	 *
+	 * @param id ID.
+	 * @return whether the ID changed.
+	 */
+	bool IsChanged(int id) const {
+		return id >= 0 && id < (int)dirty.size() && dirty[id];
+	}
+
+	/**
+	 * Gets the IDs changed since the last ClearChanged, in order of their
+	 * first change.
+	 *
+	 * @return changed IDs.
+	 */
+	const std::vector<int>& GetChanged() const {
+		return changed;
+	}
+
+	/**
+	 * Forgets the changed IDs. The journal is kept.
+	 */
+	void ClearChanged() {
+		for (std::vector<int>::const_iterator it = changed.begin(); it != changed.end(); ++it) {
+			dirty[*it] = false;
+		}
+		changed.clear();
+	}
+
+	/**
+	 * Sets the number of journal entries to keep, 0 disables the journal.
+	 *
+	 * @param size maximum journal size.
+	 */
+	void SetJournalSize(size_t size) {
+		journal_size = size;
+		while (journal.size() > journal_size) {
+			journal.pop_front();
+		}
+	}
+
+	/**
+	 * Gets the journal, oldest change first.
+	 *
+	 * @return journal entries.
+	 */
+	const std::deque<Entry>& GetJournal() const {
+		return journal;
+	}
+
+	/**
+	 * Forgets the changed IDs and the journal.
+	 */
+	void Clear() {
+		ClearChanged();
+		journal.clear();
+	}
+
+private:
+	std::vector<bool> dirty;
+	std::vector<int> changed;
+	std::deque<Entry> journal;
+	size_t journal_size;
+};
+
+#endif
@@ -21,12 +21,17 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <ctime>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
+#include <boost/unordered_map.hpp>
 
 #include "system.h"
 #include "options.h"
@@ -37,6 +42,7 @@
 #include "main_data.h"
 #include "reader_util.h"
 #include "registry.h"
+#include "trace.h"
 
 #ifdef _MSC_VER
 #  include "rtp_table_bom.h"
@@ -77,6 +83,190 @@ namespace {
 	search_path_list search_paths;
 	std::string fonts_path;
 
+	/** Recursive member list of a directory and the state it was taken in. */
+	struct IndexEntry {
+		/** { directory path, modification time } of all listed directories */
+		std::vector<std::pair<std::string, std::time_t> > mtimes;
+		FileFinder::string_map members;
+	};
+
+	/** { directory path, index entry } */
+	typedef std::map<std::string, IndexEntry> index_type;
+	index_type dir_index;
+	std::string index_file;
+	bool index_dirty = false;
+
+	const char* const INDEX_HEADER = "EasyRPG FileFinder index 1";
+
+	struct IndexStats {
+		IndexStats() : scanned(0), cached(0), time_ns(0) {}
+
+		int scanned, cached;
+		uint64_t time_ns;
+	};
+
+	/** { tree path, indexing statistic } */
+	std::map<std::string, IndexStats> index_stats;
+
+	/**
+	 * Key of the lookup cache. The extension list identifies the file type,
+	 * all callers pass static arrays.
+	 */
+	struct LookupKey {
+		LookupKey(std::string const& dir, std::string const& name, char const** exts) :
+			dir(dir), name(name), exts(exts) {}
+
+		std::string dir, name;
+		char const** exts;
+	};
+
+	/** Non owning variant of LookupKey, used to look up without allocating. */
+	struct LookupKeyRef {
+		LookupKeyRef(std::string const& dir, std::string const& name, char const** exts) :
+			dir(dir), name(name), exts(exts) {}
+
+		std::string const& dir;
+		std::string const& name;
+		char const** exts;
+	};
+
+	template<class Key>
+	std::size_t hash_lookup_key(Key const& k) {
+		std::size_t seed = boost::hash_range(k.dir.begin(), k.dir.end());
+		boost::hash_range(seed, k.name.begin(), k.name.end());
+		boost::hash_combine(seed, k.exts);
+		return seed;
+	}
+
+	struct LookupKeyHash {
+		std::size_t operator()(LookupKey const& k) const { return hash_lookup_key(k); }
+		std::size_t operator()(LookupKeyRef const& k) const { return hash_lookup_key(k); }
+	};
+
+	struct LookupKeyEqual {
+		template<class A, class B>
+		bool operator()(A const& a, B const& b) const {
+			return a.exts == b.exts && a.dir == b.dir && a.name == b.name;
+		}
+	};
+
+	/** { lookup, found path or empty string when the file does not exist } */
+	typedef boost::unordered_map<LookupKey, std::string, LookupKeyHash, LookupKeyEqual> lookup_cache_type;
+	lookup_cache_type lookup_cache;
+	/** Escape symbol the cached lookups were resolved with */
+	std::string lookup_cache_escape;
+
+	void ClearLookupCache() {
+		lookup_cache.clear();
+	}
+
+	bool GetModificationTime(std::string const& path, std::time_t& mtime) {
+#ifdef _WIN32
+		struct _stat sb;
+		if (::_wstat(Utils::ToWideString(path).c_str(), &sb) != 0) { return false; }
+#else
+		struct stat sb;
+		if (::stat(path.c_str(), &sb) != 0) { return false; }
+#endif
+		mtime = sb.st_mtime;
+		return true;
+	}
+
+	void IndexDirectory(std::string const& path, std::string const& parent, IndexEntry& entry) {
+		using namespace FileFinder;
+
+		std::time_t mtime;
+		if (GetModificationTime(path, mtime)) {
+			entry.mtimes.push_back(std::make_pair(path, mtime));
+		}
+
+		Directory const mem = GetDirectoryMembers(path, ALL);
+		for (string_map::const_iterator i = mem.members.begin(); i != mem.members.end(); ++i) {
+			std::string const name = MakePath(parent, i->second);
+			if (IsDirectory(MakePath(path, i->second))) {
+				IndexDirectory(MakePath(path, i->second), name, entry);
+			} else {
+				entry.members[Utils::LowerCase(name)] = name;
+			}
+		}
+	}
+
+	bool IsIndexEntryValid(IndexEntry const& entry) {
+		if (entry.mtimes.empty()) { return false; }
+
+		for (size_t i = 0; i < entry.mtimes.size(); ++i) {
+			std::time_t mtime;
+			if (!GetModificationTime(entry.mtimes[i].first, mtime) ||
+				mtime != entry.mtimes[i].second) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool IsIndexable(std::string const& str) {
+		return str.find_first_of("\t\n") == std::string::npos;
+	}
+
+	void LoadIndex() {
+		EASYRPG_SHARED_PTR<std::fstream> in = FileFinder::openUTF8(index_file, std::ios_base::in);
+		if (!in) { return; }
+
+		std::string line;
+		if (!std::getline(*in, line) || line != INDEX_HEADER) {
+			Output::Debug("Ignoring invalid index file %s", index_file.c_str());
+			return;
+		}
+
+		IndexEntry* entry = NULL;
+		while (std::getline(*in, line)) {
+			std::string::size_type const sep = line.find('\t', 2);
+			if (line.size() < 2 || line[1] != '\t') { continue; }
+
+			switch (line[0]) {
+			case 'D':
+				entry = &dir_index[line.substr(2)];
+				entry->mtimes.clear();
+				entry->members.clear();
+				break;
+			case 'T':
+				if (entry && sep != std::string::npos) {
+					std::istringstream ss(line.substr(2, sep - 2));
+					std::time_t mtime = 0;
+					ss >> mtime;
+					entry->mtimes.push_back(std::make_pair(line.substr(sep + 1), mtime));
+				}
+				break;
+			case 'F':
+				if (entry && sep != std::string::npos) {
+					entry->members[line.substr(2, sep - 2)] = line.substr(sep + 1);
+				}
+				break;
+			}
+		}
+
+		Output::Debug("Loaded %d directories from index %s", (int)dir_index.size(), index_file.c_str());
+	}
+
+	void SaveIndex() {
+		EASYRPG_SHARED_PTR<std::fstream> out = FileFinder::openUTF8(index_file, std::ios_base::out | std::ios_base::trunc);
+		if (!out) {
+			Output::Debug("Cannot write index file %s", index_file.c_str());
+			return;
+		}
+
+		*out << INDEX_HEADER << "\n";
+		for (index_type::const_iterator i = dir_index.begin(); i != dir_index.end(); ++i) {
+			*out << "D\t" << i->first << "\n";
+			for (size_t j = 0; j < i->second.mtimes.size(); ++j) {
+				*out << "T\t" << i->second.mtimes[j].second << "\t" << i->second.mtimes[j].first << "\n";
+			}
+			for (FileFinder::string_map::const_iterator j = i->second.members.begin(); j != i->second.members.end(); ++j) {
+				*out << "F\t" << j->first << "\t" << j->second << "\n";
+			}
+		}
+	}
+
 	boost::optional<std::string> FindFile(FileFinder::ProjectTree const& tree,
 										  std::string const& dir,
 										  std::string const& name,
@@ -99,11 +289,12 @@ namespace {
 		string_map::const_iterator dir_it = tree.directories.find(lower_dir);
 		if(dir_it == tree.directories.end()) { return boost::none; }
 
-		string_map const& dir_map = tree.sub_members.find(lower_dir)->second;
+		string_map const* const dir_map = GetSubMembers(tree, lower_dir);
+		if(!dir_map) { return boost::none; }
 
 		for(char const** c = exts; *c != NULL; ++c) {
-			string_map::const_iterator const name_it = dir_map.find(corrected_name + *c);
-			if(name_it != dir_map.end()) {
+			string_map::const_iterator const name_it = dir_map->find(corrected_name + *c);
+			if(name_it != dir_map->end()) {
 				return MakePath
 					(std::string(tree.project_path).append("/")
 					 .append(dir_it->second), name_it->second);
@@ -119,11 +310,36 @@ namespace {
 		return std::find_if(n.begin(), n.end(), &is_not_ascii_char) != n.end();
 	}
 
+	/** { UTF-8, ASCII } */
+	typedef boost::unordered_map<std::string, std::string> rtp_reverse_map_type;
+	/** { folder: { UTF-8, ASCII } } */
+	typedef boost::unordered_map<std::string, rtp_reverse_map_type> rtp_reverse_table_type;
+
+	rtp_reverse_table_type create_reverse_rtp_table(rtp_table_type const& table) {
+		rtp_reverse_table_type ret;
+		for (rtp_table_type::const_iterator dir_it = table.begin(); dir_it != table.end(); ++dir_it) {
+			rtp_reverse_map_type& dir_map = ret[dir_it->first];
+			for (sub_map_type::const_iterator it = dir_it->second.begin(); it != dir_it->second.end(); ++it) {
+				// insert keeps the first match like a linear search would
+				dir_map.insert(std::make_pair(it->second, it->first));
+			}
+		}
+		return ret;
+	}
+
+	rtp_reverse_table_type const& reverse_rtp_table() {
+		static rtp_reverse_table_type const table_2000 = create_reverse_rtp_table(RTP_TABLE_2000);
+		static rtp_reverse_table_type const table_2003 = create_reverse_rtp_table(RTP_TABLE_2003);
+
+		return Player::IsRPG2k() ? table_2000 : table_2003;
+	}
+
 	std::string const& translate_rtp(std::string const& dir, std::string const& name) {
 		rtp_table_type const& table =
 			Player::IsRPG2k() ? RTP_TABLE_2000 : RTP_TABLE_2003;
 
-		rtp_table_type::const_iterator dir_it = table.find(Utils::LowerCase(dir));
+		std::string const lower_dir = Utils::LowerCase(dir);
+		rtp_table_type::const_iterator dir_it = table.find(lower_dir);
 		std::string lower_name = Utils::LowerCase(name);
 
 		if (dir_it == table.end()) { return name; }
@@ -132,10 +348,13 @@ namespace {
 			dir_it->second.find(lower_name);
 		if (file_it == dir_it->second.end()) {
 			if (is_not_ascii_filename(lower_name)) {
-				// Linear Search: Japanese file name to English file name
-				for (std::map<std::string, std::string>::const_iterator it = dir_it->second.begin(); it != file_it; ++it) {
-					if (it->second == lower_name) {
-						return it->first;
+				// Japanese file name to English file name
+				rtp_reverse_table_type const& reverse_table = reverse_rtp_table();
+				rtp_reverse_table_type::const_iterator const rdir_it = reverse_table.find(lower_dir);
+				if (rdir_it != reverse_table.end()) {
+					rtp_reverse_map_type::const_iterator const rfile_it = rdir_it->second.find(lower_name);
+					if (rfile_it != rdir_it->second.end()) {
+						return rfile_it->second;
 					}
 				}
 			}
@@ -144,8 +363,7 @@ namespace {
 		return file_it->second;
 	}
 
-	std::string FindFile(const std::string &dir, const std::string& name, const char* exts[]) {
-		FileFinder::ProjectTree const& tree = FileFinder::GetProjectTree();
+	std::string FindFileUncached(FileFinder::ProjectTree const& tree, const std::string &dir, const std::string& name, const char* exts[]) {
 		boost::optional<std::string> const ret = FindFile(tree, dir, name, exts);
 		if (ret != boost::none) { return *ret; }
 
@@ -167,9 +385,31 @@ namespace {
 		return std::string();
 	}
 
+	std::string const& FindFile(const std::string &dir, const std::string& name, const char* exts[]) {
+		TRACE_SCOPE("file", "FileFinder::FindFile");
+
+		// Resolves the tree first, rebuilding it invalidates the cache
+		FileFinder::ProjectTree const& tree = FileFinder::GetProjectTree();
+
+		if (lookup_cache_escape != Player::escape_symbol) {
+			ClearLookupCache();
+			lookup_cache_escape = Player::escape_symbol;
+		}
+
+		lookup_cache_type::const_iterator const it =
+			lookup_cache.find(LookupKeyRef(dir, name, exts), LookupKeyHash(), LookupKeyEqual());
+		if (it != lookup_cache.end()) { return it->second; }
+
+		// Node based, the returned entry is not moved by later inserts
+		return lookup_cache.insert(std::make_pair(LookupKey(dir, name, exts),
+			FindFileUncached(tree, dir, name, exts))).first->second;
+	}
+
 } // anonymous namespace
 
 EASYRPG_SHARED_PTR<FileFinder::ProjectTree> FileFinder::CreateProjectTree(std::string const& p, bool recursive) {
+	TRACE_SCOPE("file", "FileFinder::CreateProjectTree");
+
 	if(! (Exists(p) && IsDirectory(p))) { return EASYRPG_SHARED_PTR<ProjectTree>(); }
 
 	EASYRPG_SHARED_PTR<ProjectTree> tree = EASYRPG_MAKE_SHARED<ProjectTree>();
@@ -181,16 +421,61 @@ EASYRPG_SHARED_PTR<FileFinder::ProjectTree> FileFinder::CreateProjectTree(std::s
 		 tree->directories : tree->files)[i->first] = i->second;
 	}
 
-	// Stop here if the tree is invalid
-	if (p == Main_Data::project_path && !IsRPG2kProject(*tree) && !IsEasyRpgProject(*tree))
-		return tree;
+	// Subdirectories are indexed on demand by GetSubMembers
+	return tree;
+}
+
+FileFinder::string_map const* FileFinder::GetSubMembers(ProjectTree const& tree, std::string const& dir) {
+	sub_members_type::const_iterator const sub_it = tree.sub_members.find(dir);
+	if (sub_it != tree.sub_members.end()) { return &sub_it->second; }
 
-	for(string_map::const_iterator i = tree->directories.begin(); i != tree->directories.end(); ++i) {
-		GetDirectoryMembers(MakePath(tree->project_path, i->second), RECURSIVE)
-			.members.swap(tree->sub_members[i->first]);
+	string_map::const_iterator const dir_it = tree.directories.find(dir);
+	if (dir_it == tree.directories.end()) { return NULL; }
+
+	uint64_t const start = Utils::GetTimeNs();
+	std::string const path = MakePath(tree.project_path, dir_it->second);
+	IndexStats& stats = index_stats[tree.project_path];
+	string_map& members = tree.sub_members[dir];
+
+	index_type::const_iterator const index_it = dir_index.find(path);
+	if (index_it != dir_index.end() && IsIndexEntryValid(index_it->second)) {
+		members = index_it->second.members;
+		++stats.cached;
+	} else {
+		IndexEntry entry;
+		IndexDirectory(path, "", entry);
+		members = entry.members;
+		++stats.scanned;
+
+		if (!index_file.empty() && IsIndexable(path)) {
+			bool indexable = true;
+			for (string_map::const_iterator i = members.begin(); indexable && i != members.end(); ++i) {
+				indexable = IsIndexable(i->second);
+			}
+			for (size_t i = 0; indexable && i < entry.mtimes.size(); ++i) {
+				indexable = IsIndexable(entry.mtimes[i].first);
+			}
+			if (indexable) {
+				dir_index[path].mtimes.swap(entry.mtimes);
+				dir_index[path].members.swap(entry.members);
+				index_dirty = true;
+			}
+		}
 	}
 
-	return tree;
+	stats.time_ns += Utils::GetTimeNs() - start;
+
+	return &members;
+}
+
+void FileFinder::SetIndexFile(std::string const& file) {
+	index_file = file;
+	dir_index.clear();
+	index_dirty = false;
+
+	if (!index_file.empty()) {
+		LoadIndex();
+	}
 }
 
 std::string FileFinder::MakePath(const std::string &dir, std::string const& name) {
@@ -293,6 +578,7 @@ FileFinder::ProjectTree const& FileFinder::GetProjectTree(bool init) {
 			return tree_;
 		}
 		tree_ = *t;
+		ClearLookupCache();
 	}
 
 	return tree_;
@@ -308,6 +594,7 @@ static void add_rtp_path(std::string const& p) {
 	if(tree) {
 		Output::Debug("Adding %s to RTP path", p.c_str());
 		search_paths.push_back(tree);
+		ClearLookupCache();
 	}
 }
 
@@ -329,6 +616,9 @@ void FileFinder::InitRtpPaths() {
 	return;
 #endif
 
+	// Build the name translation index now instead of on the first lookup
+	reverse_rtp_table();
+
 	std::string const version_str =
 		Player::IsRPG2k() ? "2000" :
 		Player::IsRPG2k3() ? "2003" :
@@ -392,7 +682,19 @@ void FileFinder::InitRtpPaths() {
 }
 
 void FileFinder::Quit() {
+	for (std::map<std::string, IndexStats>::const_iterator i = index_stats.begin(); i != index_stats.end(); ++i) {
+		Output::Debug("Indexing %s: %d directories scanned, %d from index, %.2f ms",
+			i->first.c_str(), i->second.scanned, i->second.cached, i->second.time_ns / 1000000.0);
+	}
+	index_stats.clear();
+
+	if (index_dirty) {
+		SaveIndex();
+		index_dirty = false;
+	}
+
 	search_paths.clear();
+	ClearLookupCache();
 }
 
 FILE* FileFinder::fopenUTF8(const std::string& name_utf8, char const* mode) {
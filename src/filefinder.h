@@ -58,10 +58,16 @@ namespace FileFinder {
 	*/
 	typedef boost::container::flat_map<std::string, string_map> sub_members_type;
 
+	/**
+	 * Case insensitive file index of a directory.
+	 * Only the top level is listed when the tree is created, subdirectories
+	 * are indexed on their first lookup (see GetSubMembers).
+	 */
 	struct ProjectTree {
 		std::string project_path;
 		string_map files, directories;
-		sub_members_type sub_members;
+		/** Subdirectories indexed so far, filled by GetSubMembers. */
+		mutable sub_members_type sub_members;
 	}; // struct ProjectTree
 
 	/**
@@ -213,6 +219,27 @@ namespace FileFinder {
 	ProjectTree const& GetProjectTree(bool init = false);
 	EASYRPG_SHARED_PTR<ProjectTree> CreateProjectTree(std::string const& p, bool recursive = true);
 
+	/**
+	 * Gets the recursive member list of a subdirectory of a tree.
+	 * The directory is indexed on the first call, either by scanning it or
+	 * by taking the entry of the index file when it is still up to date.
+	 *
+	 * @param tree project tree.
+	 * @param dir case lowered directory name.
+	 * @return member list, NULL if the directory does not exist.
+	 *         Only valid until the next call with the same tree.
+	 */
+	string_map const* GetSubMembers(ProjectTree const& tree, std::string const& dir);
+
+	/**
+	 * Loads a directory index file and enables writing it back on Quit.
+	 * Index entries are keyed by the modification times of the directories
+	 * and replace scanning a directory as long as these times match.
+	 *
+	 * @param file path of the index file, may not exist yet.
+	 */
+	void SetIndexFile(std::string const& file);
+
 	bool IsRPG2kProject(ProjectTree const& dir);
 	bool IsEasyRpgProject(ProjectTree const& dir);
 } // namespace FileFinder
@@ -145,6 +145,7 @@ BitmapRef ShinonomeFont::Glyph(unsigned code) {
 	assert(glyph);
 	size_t const width = glyph->is_full? FULL_WIDTH : HALF_WIDTH;
 
+	Bitmap::MemoryScope memory_scope(Bitmap::MemoryFont);
 	BitmapRef bm = Bitmap::Create(reinterpret_cast<void*>(NULL), width, HEIGHT, 0, DynamicFormat(8,8,0,8,0,8,0,8,0,PF::Alpha));
 	uint8_t* data = reinterpret_cast<uint8_t*>(bm->pixels());
 	int pitch = bm->pitch();
@@ -194,6 +195,7 @@ BitmapRef FTFont::Glyph(unsigned glyph) {
 	int const width = ft_bitmap.width;
 	int const height = ft_bitmap.rows;
 
+	Bitmap::MemoryScope memory_scope(Bitmap::MemoryFont);
 	BitmapRef bm = Bitmap::Create(reinterpret_cast<void*>(NULL), width, height, 0, DynamicFormat(8,8,0,8,0,8,0,8,0,PF::Alpha));
 	uint8_t* data = reinterpret_cast<uint8_t*>(bm->pixels());
 	int dst_pitch = bm->pitch();
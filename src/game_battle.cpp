@@ -28,6 +28,7 @@
 #include "game_interpreter_battle.h"
 #include "battle_animation.h"
 #include "game_battle.h"
+#include "graphics.h"
 #include "spriteset_battle.h"
 #include <boost/scoped_ptr.hpp>
 
@@ -91,7 +92,9 @@ void Game_Battle::Quit() {
 }
 
 void Game_Battle::Update() {
+	uint64_t const interpreter_start = Graphics::BeginPhase();
 	interpreter->Update();
+	Graphics::EndPhase(Graphics::PhaseInterpreter, interpreter_start);
 	spriteset->Update();
 }
 
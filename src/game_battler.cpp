@@ -227,7 +227,7 @@ bool Game_Battler::UseSkill(int skill_id) {
 			break;
 		case RPG::Skill::Type_switch:
 			SetSp(GetSp() - skill.sp_cost);
-			Game_Switches[skill.switch_id] = true;
+			Game_Switches.Set(skill.switch_id, true);
 			break;
 	}
 
@@ -27,6 +27,7 @@
 #include "game_message.h"
 #include "player.h"
 #include "util_macro.h"
+#include <algorithm>
 #include <cmath>
 #include <cassert>
 #include <cstdlib>
@@ -258,6 +259,24 @@ void Game_Character::Update() {
 	}
 }
 
+void Game_Character::FastForward(int frames) {
+	stop_count += frames;
+	wait_count = std::max(0, wait_count - frames);
+
+	// Same per frame increase as UpdateMove and UpdateStop, a pending
+	// animation step happens on the next Update
+	int anime_step = 0;
+	if ((IsContinuous() || IsSpinning()) && animation_type != RPG::EventPage::AnimType_fixed_graphic && walk_animation) {
+		++anime_step;
+	}
+	if (pattern != original_pattern && !IsContinuous()) {
+		++anime_step;
+	}
+	if (anime_step > 0) {
+		anime_count = std::min(anime_count + frames * anime_step, std::max(anime_count, GetSteppingSpeed()));
+	}
+}
+
 void Game_Character::UpdateMove() {
 	if (remaining_step > 0)
 		remaining_step -= pow(2.0, 1 + GetMoveSpeed());
@@ -505,12 +524,10 @@ void Game_Character::MoveTypeCustom() {
 					SetMoveFrequency(max(GetMoveFrequency() - 1, 1));
 					break;
 				case RPG::MoveCommand::Code::switch_on: // Parameter A: Switch to turn on
-					Game_Switches[move_command.parameter_a] = true;
-					Game_Map::SetNeedRefresh(true);
+					Game_Switches.Set(move_command.parameter_a, true);
 					break;
 				case RPG::MoveCommand::Code::switch_off: // Parameter A: Switch to turn off
-					Game_Switches[move_command.parameter_a] = false;
-					Game_Map::SetNeedRefresh(true);
+					Game_Switches.Set(move_command.parameter_a, false);
 					break;
 				case RPG::MoveCommand::Code::change_graphic: // String: File, Parameter A: index
 					SetGraphic(move_command.parameter_string, move_command.parameter_a);
@@ -615,7 +632,7 @@ void Game_Character::MoveTowardsPlayer() {
 	int sx = DistanceXfromPlayer();
 	int sy = DistanceYfromPlayer();
 
-	if (sx != 0 || sy != 0) {
+	if ((sx != 0 || sy != 0) && !MoveAlongPlayerDistance(true)) {
 		if ( std::abs(sx) > std::abs(sy) ) {
 			Move((sx > 0) ? Left : Right);
 			if (move_failed && sy != 0)
@@ -633,7 +650,7 @@ void Game_Character::MoveAwayFromPlayer() {
 	int sx = DistanceXfromPlayer();
 	int sy = DistanceYfromPlayer();
 
-	if (sx != 0 || sy != 0) {
+	if ((sx != 0 || sy != 0) && !MoveAlongPlayerDistance(false)) {
 		if ( std::abs(sx) > std::abs(sy) ) {
 			Move((sx > 0) ? Right : Left);
 			if (move_failed && sy != 0)
@@ -646,6 +663,48 @@ void Game_Character::MoveAwayFromPlayer() {
 	}
 }
 
+bool Game_Character::MoveAlongPlayerDistance(bool towards) {
+	int distance = Game_Map::GetPlayerDistance(GetX(), GetY());
+	if (distance < 0) {
+		return false;
+	}
+
+	int sx = DistanceXfromPlayer();
+	int sy = DistanceYfromPlayer();
+	int horizontal = ((sx > 0) == towards) ? Left : Right;
+	int vertical = ((sy > 0) == towards) ? Up : Down;
+
+	// Same preference as the direct approach, then the opposite directions
+	int directions[4];
+	if (std::abs(sx) > std::abs(sy)) {
+		directions[0] = horizontal;
+		directions[1] = vertical;
+	} else {
+		directions[0] = vertical;
+		directions[1] = horizontal;
+	}
+	directions[2] = (directions[1] + 2) % 4;
+	directions[3] = (directions[0] + 2) % 4;
+
+	int const step = towards ? -1 : 1;
+	bool found = false;
+	for (int i = 0; i < 4; ++i) {
+		int x = Game_Map::XwithDirection(GetX(), directions[i]);
+		int y = Game_Map::YwithDirection(GetY(), directions[i]);
+		if (Game_Map::GetPlayerDistance(x, y) != distance + step) {
+			continue;
+		}
+
+		found = true;
+		Move(directions[i]);
+		if (!move_failed) {
+			break;
+		}
+	}
+
+	return found;
+}
+
 void Game_Character::Turn(int dir) {
 	SetDirection(dir);
 	SetSpriteDirection(dir);
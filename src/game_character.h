@@ -428,6 +428,14 @@ public:
 	 */
 	void MoveAwayFromPlayer();
 
+	/**
+	 * Does a step along Game_Map::GetPlayerDistance.
+	 *
+	 * @param towards true to approach the player, false to flee.
+	 * @return false when no step changes the distance as requested.
+	 */
+	bool MoveAlongPlayerDistance(bool towards);
+
 	/**
 	 * Turns the character 90 Degree to the left.
 	 */
@@ -688,6 +696,14 @@ protected:
 	void UpdateSelfMovement();
 	void UpdateStop();
 
+	/**
+	 * Advances the timers of a stopped character by frames without
+	 * moving it. Used to catch up after skipped updates.
+	 *
+	 * @param frames number of skipped frames.
+	 */
+	void FastForward(int frames);
+
 	int tile_id;
 	int pattern;
 	int original_pattern;
@@ -21,6 +21,7 @@
 #include "game_switches.h"
 #include "game_interpreter_map.h"
 #include "game_interpreter_battle.h"
+#include "graphics.h"
 #include "main_data.h"
 
 Game_CommonEvent::Game_CommonEvent(int common_event_id, bool battle) :
@@ -66,9 +67,11 @@ void Game_CommonEvent::Update() {
 
 	if (interpreter) {
 		if (!interpreter->IsRunning()) {
-			interpreter->Setup(GetList(), 0, -common_event_id, -2);
-		} else {
+			interpreter->Setup(GetList(), 0, -common_event_id, -2, common_event_id);
+		} else if (!interpreter->IsParked()) {
+			uint64_t const interpreter_start = Graphics::BeginPhase();
 			interpreter->Update();
+			Graphics::EndPhase(Graphics::PhaseInterpreter, interpreter_start);
 		}
 	}
 }
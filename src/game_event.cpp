@@ -27,6 +27,7 @@
 #include "game_variables.h"
 #include "game_system.h"
 #include "game_interpreter_map.h"
+#include "graphics.h"
 #include "main_data.h"
 #include "player.h"
 #include <cmath>
@@ -38,7 +39,8 @@ Game_Event::Game_Event(int map_id, const RPG::Event& event) :
 	trigger(-1),
 	event(event),
 	page(NULL),
-	from_save(false) {
+	from_save(false),
+	sleep_frames(0) {
 
 	ID = event.ID;
 
@@ -54,7 +56,8 @@ Game_Event::Game_Event(int /* map_id */, const RPG::Event& event, const RPG::Sav
 	ready2(true),
 	event(event),
 	page(NULL),
-	from_save(true) {
+	from_save(true),
+	sleep_frames(0) {
 
 	ID = data.ID;
 
@@ -74,7 +77,9 @@ int Game_Event::GetX() const {
 }
 
 void Game_Event::SetX(int new_x) {
+	int const old_x = data.position_x;
 	data.position_x = new_x;
+	Game_Map::UpdateEventPosition(this, old_x, data.position_y);
 }
 
 int Game_Event::GetY() const {
@@ -82,7 +87,9 @@ int Game_Event::GetY() const {
 }
 
 void Game_Event::SetY(int new_y) {
+	int const old_y = data.position_y;
 	data.position_y = new_y;
+	Game_Map::UpdateEventPosition(this, data.position_x, old_y);
 }
 
 int Game_Event::GetMapId() const {
@@ -258,7 +265,6 @@ void Game_Event::Setup(RPG::EventPage* new_page) {
 		SetDirection(RPG::EventPage::Direction_down);
 		//move_type = 0;
 		trigger = -1;
-		list.clear();
 		return;
 	}
 	SetSpriteName(page->character_name);
@@ -288,7 +294,6 @@ void Game_Event::Setup(RPG::EventPage* new_page) {
 
 	SetLayer(page->layer);
 	trigger = page->trigger;
-	list = page->event_commands;
 
 	if (trigger == RPG::EventPage::Trigger_parallel) {
 		interpreter.reset(new Game_Interpreter_Map());
@@ -303,7 +308,6 @@ void Game_Event::SetupFromSave(RPG::EventPage* new_page) {
 		tile_id = 0;
 		through = true;
 		trigger = -1;
-		list.clear();
 		interpreter.reset();
 		return;
 	}
@@ -321,7 +325,6 @@ void Game_Event::SetupFromSave(RPG::EventPage* new_page) {
 	original_move_route = page->move_route;
 	animation_type = page->animation_type;
 	trigger = page->trigger;
-	list = page->event_commands;
 
 	// Trigger parallel events when the interpreter wasn't already running
 	// (because it was the middle of a parallel event while saving)
@@ -464,7 +467,7 @@ bool Game_Event::GetActive() const {
 
 void Game_Event::Start() {
 	// RGSS scripts consider list empty if size <= 1. Why?
-	if (list.empty() || !data.active || !ready1 || !ready2)
+	if (GetList().empty() || !data.active || !ready1 || !ready2)
 		return;
 
 	starting = true;
@@ -480,8 +483,9 @@ void Game_Event::CheckEventTriggerAuto() {
 	}
 }
 
-std::vector<RPG::EventCommand>& Game_Event::GetList() {
-	return list;
+const std::vector<RPG::EventCommand>& Game_Event::GetList() const {
+	static const std::vector<RPG::EventCommand> empty_list;
+	return page ? page->event_commands : empty_list;
 }
 
 void Game_Event::StartTalkToHero() {
@@ -524,19 +528,38 @@ void Game_Event::Update() {
 	ready2 = ready1;
 	ready1 = true;
 
+	if (sleep_frames > 0) {
+		FastForward(sleep_frames);
+		sleep_frames = 0;
+	}
+
 	Game_Character::Update();
 
 	CheckEventTriggerAuto();
 
 	if (interpreter) {
 		if (!interpreter->IsRunning()) {
-			interpreter->Setup(list, event.ID, -event.x, event.y);
-		} else {
+			interpreter->Setup(GetList(), event.ID, -event.x, event.y);
+		} else if (!interpreter->IsParked()) {
+			uint64_t const interpreter_start = Graphics::BeginPhase();
 			interpreter->Update();
+			Graphics::EndPhase(Graphics::PhaseInterpreter, interpreter_start);
 		}
 	}
 }
 
+bool Game_Event::CanSleep() const {
+	return data.active && !interpreter && !starting &&
+		trigger != RPG::EventPage::Trigger_auto_start &&
+		trigger != RPG::EventPage::Trigger_parallel &&
+		move_type != RPG::EventPage::MoveType_custom &&
+		!IsMoveRouteOverwritten() && IsStopping();
+}
+
+void Game_Event::Sleep() {
+	++sleep_frames;
+}
+
 RPG::Event& Game_Event::GetEvent() {
 	return event;
 }
@@ -129,11 +129,12 @@ public:
 	bool GetThrough() const;
 
 	/**
-	 * Gets event commands list.
+	 * Gets event commands list of the active page.
+	 * The list is owned by the page, interpreters cache its jump table.
 	 *
-	 * @return event commands list.
+	 * @return event commands list, empty without an active page.
 	 */
-	std::vector<RPG::EventCommand>& GetList();
+	const std::vector<RPG::EventCommand>& GetList() const;
 
 	/**
 	 * Event's sprite looks towards the hero but its original direction is remembered.
@@ -149,6 +150,21 @@ public:
 	bool CheckEventTriggerTouch(int x, int y);
 	void Start();
 	void Update();
+
+	/**
+	 * Checks whether the event can skip updates while it is off-screen:
+	 * It does not run or start an interpreter, does not move on its own
+	 * route and stands still.
+	 *
+	 * @return whether the event may sleep.
+	 */
+	bool CanSleep() const;
+
+	/**
+	 * Skips the update of this frame. The timers catch up on the next Update.
+	 */
+	void Sleep();
+
 	bool AreConditionsMet(const RPG::EventPage& page);
 
 	/**
@@ -180,9 +196,10 @@ private:
 	int trigger;
 	RPG::Event event;
 	RPG::EventPage* page;
-	std::vector<RPG::EventCommand> list;
 	EASYRPG_SHARED_PTR<Game_Interpreter> interpreter;
 	bool from_save;
+	/** Frames skipped by Sleep since the last Update. */
+	int sleep_frames;
 };
 
 #endif
@@ -16,6 +16,7 @@
  */
 
 // Headers
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
@@ -38,10 +39,13 @@
 #include "scene.h"
 #include "graphics.h"
 #include "input.h"
+#include "interpreter_profiler.h"
 #include "main_data.h"
 #include "output.h"
 #include "player.h"
+#include "trace.h"
 #include "util_macro.h"
+#include "utils.h"
 
 Game_Interpreter::Game_Interpreter(int _depth, bool _main_flag) {
 	depth = _depth;
@@ -69,8 +73,11 @@ void Game_Interpreter::Clear() {
 	map_id = 0;						// map ID when starting up
 	CloseMessageWindow();
 	event_id = 0;					// event ID
+	common_event_id = 0;
 	move_route_waiting = false;		// waiting for move completion
 	wait_count = 0;					// wait count
+	block_reason = BlockNone;
+	block_frame = 0;
 	continuation = NULL;			// function to execute to resume command
 	button_timer = 0;
 	if (child_interpreter) {		// clear child interpreter for called events
@@ -80,6 +87,8 @@ void Game_Interpreter::Clear() {
 			child_interpreter.reset();
 	}			
 	list.clear();
+	jump_table.reset();
+	compiled_list.reset();
 }
 
 // Is interpreter running.
@@ -88,13 +97,16 @@ bool Game_Interpreter::IsRunning() const {
 }
 
 // Setup.
-void Game_Interpreter::Setup(const std::vector<RPG::EventCommand>& _list, int _event_id, int dbg_x, int dbg_y) {
+void Game_Interpreter::Setup(const std::vector<RPG::EventCommand>& _list, int _event_id, int dbg_x, int dbg_y, int _common_event_id) {
 
 	Clear();
 
 	map_id = Game_Map::GetMapId();
 	event_id = _event_id;
+	common_event_id = _common_event_id;
 	list = _list;
+	jump_table = JumpTable::Get(_list);
+	compiled_list = GetCompiledListCache().Get(*this, _list);
 
 	debug_x = dbg_x;
 	debug_y = dbg_y;
@@ -133,8 +145,46 @@ void Game_Interpreter::EndMoveRoute(Game_Character*) {
 	// This will only ever be called on Game_Interpreter_Map instances
 }
 
+bool Game_Interpreter::IsMessageBlocking() const {
+	return (Game_Message::message_waiting || Game_Message::closing)
+		&& (main_flag || Game_Message::owner_id == event_id);
+}
+
+int Game_Interpreter::GetWaitCount() const {
+	if (block_reason != BlockWait) {
+		return wait_count;
+	}
+
+	// The map updates once per interpreter update, every further
+	// update was skipped by the owner. Battles don't update the map.
+	int skipped = std::max(0, Game_Map::GetUpdateCount() - block_frame - 1);
+	return std::max(0, wait_count - skipped);
+}
+
+bool Game_Interpreter::IsParked() const {
+	// A message can pause the wait, let Update decide
+	if (Game_Message::message_waiting || Game_Message::closing) {
+		return false;
+	}
+
+	// Nothing checked before these in Update changes while parked
+	switch (block_reason) {
+		case BlockWait:
+			return GetWaitCount() > 0;
+		case BlockTransition:
+			return Game_Temp::transition_processing;
+		default:
+			return false;
+	}
+}
+
 // Update
 void Game_Interpreter::Update() {
+	wait_count = GetWaitCount();
+	block_reason = BlockNone;
+
+	TRACE_SCOPE("interpreter", "Game_Interpreter::Update");
+
 	updating = true;
 	// 10000 based on: https://gist.github.com/4406621
 	for (loop_count = 0; loop_count < 10000; ++loop_count) {
@@ -160,9 +210,8 @@ void Game_Interpreter::Update() {
 			}
 		}
 
-		if ((Game_Message::message_waiting || Game_Message::closing)
-			&& (main_flag || Game_Message::owner_id == event_id)) {
-				break;
+		if (IsMessageBlocking()) {
+			break;
 		}
 
 		// If waiting for a move to end
@@ -184,6 +233,8 @@ void Game_Interpreter::Update() {
 
 		if (wait_count > 0) {
 			wait_count--;
+			block_reason = BlockWait;
+			block_frame = Game_Map::GetUpdateCount();
 			break;
 		}
 
@@ -192,6 +243,7 @@ void Game_Interpreter::Update() {
 		}
 
 		if (Game_Temp::transition_processing) {
+			block_reason = BlockTransition;
 			break;
 		}
 
@@ -231,7 +283,19 @@ void Game_Interpreter::Update() {
 			break;
 		}
 
-		if (!ExecuteCommand()) {
+		bool result;
+		if (InterpreterProfiler::IsEnabled()) {
+			// Left out commands are timed with the command run after them
+			const CompiledList& compiled = GetCompiledList();
+			int code = index < list.size() ? compiled.instructions[compiled.compiled_index[index]].code : 0;
+			uint64_t start = Utils::GetTimeNs();
+			result = ExecuteCommand();
+			InterpreterProfiler::RecordCommand(map_id, common_event_id ? 0 : event_id, common_event_id, code, Utils::GetTimeNs() - start);
+		} else {
+			result = ExecuteCommand();
+		}
+
+		if (!result) {
 			CloseMessageWindow();
 			active = true;
 			break;
@@ -251,6 +315,9 @@ void Game_Interpreter::Update() {
 		// Executed Events Count exceeded (10000)
 		active = true;
 		Output::Debug("Event %d exceeded execution limit", event_id);
+		if (InterpreterProfiler::IsEnabled()) {
+			InterpreterProfiler::RecordLimitExceeded(map_id, common_event_id ? 0 : event_id, common_event_id);
+		}
 		CloseMessageWindow();
 	}
 
@@ -264,7 +331,7 @@ void Game_Interpreter::SetupStartingEvent(Game_Event* ev) {
 }
 
 void Game_Interpreter::SetupStartingEvent(Game_CommonEvent* ev) {
-	Setup(ev->GetList(), 0, ev->GetIndex(), -2);
+	Setup(ev->GetList(), 0, ev->GetIndex(), -2, ev->GetIndex());
 }
 
 void Game_Interpreter::CheckGameOver() {
@@ -274,6 +341,14 @@ void Game_Interpreter::CheckGameOver() {
 	}
 }
 
+const JumpTable& Game_Interpreter::GetJumpTable() {
+	if (!jump_table) {
+		// Restored from a save, the list has no owner to cache the table for
+		jump_table = JumpTable::Create(list);
+	}
+	return *jump_table;
+}
+
 // Skip to command.
 bool Game_Interpreter::SkipTo(int code, int code2, int min_indent, int max_indent, bool otherwise_end) {
 	if (code2 < 0)
@@ -283,96 +358,215 @@ bool Game_Interpreter::SkipTo(int code, int code2, int min_indent, int max_inden
 	if (max_indent < 0)
 		max_indent = list[index].indent;
 
-	int idx;
-	for (idx = index; (size_t) idx < list.size(); idx++) {
-		if (list[idx].indent < min_indent)
-			return false;
-		if (list[idx].indent > max_indent)
-			continue;
-		if (list[idx].code != code &&
-			list[idx].code != code2)
-			continue;
-		index = idx;
-		return true;
-	}
-
-	if (otherwise_end)
-		index = idx;
+	int idx = index;
+	bool const result = GetJumpTable().SkipTo(idx, code, code2, min_indent, max_indent, otherwise_end);
+	index = idx;
+	return result;
+}
 
-	return true;
+const Game_Interpreter::CompiledList& Game_Interpreter::GetCompiledList() {
+	if (!compiled_list) {
+		// Restored from a save, the list has no owner to cache it for
+		compiled_list = Compile(list);
+	}
+	return *compiled_list;
 }
 
 // Execute Command.
 bool Game_Interpreter::ExecuteCommand() {
-	RPG::EventCommand const& com = list[index];
+	if (index >= list.size()) {
+		return CommandEnd();
+	}
+
+	const CompiledList& compiled = GetCompiledList();
+	const Instruction& ins = compiled.instructions[compiled.compiled_index[index]];
+
+	// Commands without effect are not compiled but still count as
+	// executed commands for the limit of Update
+	int skipped = ins.source_index - (int)index;
+	if (skipped > 0) {
+		if (loop_count + skipped > 9999) {
+			// The limit is reached on a left out command
+			index += 9999 - loop_count;
+			loop_count = 9999;
+			return true;
+		}
+		index += skipped;
+		loop_count += skipped;
+	}
+
+	if (!ins.function) {
+		return CommandEnd();
+	}
+	return (this->*ins.function)(ins);
+}
+
+bool Game_Interpreter::RunCommand(Instruction const& ins) {
+	return (this->*ins.command)(list[index]);
+}
+
+namespace {
+	/** Incremented by ClearTableCaches. */
+	int table_cache_generation = 0;
+}
+
+void Game_Interpreter::ClearTableCaches() {
+	JumpTable::ClearCache();
+	++table_cache_generation;
+}
+
+Game_Interpreter::CompiledListCache::CompiledListCache() :
+	generation(table_cache_generation) {
+}
+
+Game_Interpreter::CompiledListRef Game_Interpreter::CompiledListCache::Get(
+	Game_Interpreter& interpreter, const std::vector<RPG::EventCommand>& list) {
+	if (generation != table_cache_generation) {
+		lists.clear();
+		generation = table_cache_generation;
+	}
+
+	CompiledListRef& compiled = lists[&list];
+	if (!compiled || compiled->compiled_index.size() != list.size() + 1) {
+		compiled = interpreter.Compile(list);
+	}
+	return compiled;
+}
+
+Game_Interpreter::CompiledListCache& Game_Interpreter::GetCompiledListCache() {
+	static CompiledListCache cache;
+	return cache;
+}
 
-	switch (com.code) {
+Game_Interpreter::CompiledListRef Game_Interpreter::Compile(const std::vector<RPG::EventCommand>& list) {
+	EASYRPG_SHARED_PTR<CompiledList> compiled = EASYRPG_MAKE_SHARED<CompiledList>();
+	compiled->instructions.reserve(list.size() + 1);
+	compiled->compiled_index.resize(list.size() + 1);
+
+	Instruction ins;
+	for (size_t i = 0; i < list.size(); ++i) {
+		const RPG::EventCommand& com = list[i];
+		compiled->compiled_index[i] = compiled->instructions.size();
+
+		ins.function = GetInstructionFunction(com.code);
+		ins.command = NULL;
+		if (!ins.function) {
+			ins.command = GetCommandFunction(com.code);
+			if (ins.command == &Game_Interpreter::CommandNone) {
+				continue;
+			}
+			ins.function = &Game_Interpreter::RunCommand;
+		}
+
+		ins.source_index = i;
+		ins.code = com.code;
+		ins.indent = com.indent;
+		ins.param_count = com.parameters.size();
+		for (int p = 0; p < Instruction::MaxInlineParams; ++p) {
+			ins.params[p] = p < ins.param_count ? com.parameters[p] : 0;
+		}
+		compiled->instructions.push_back(ins);
+	}
+
+	// End of the list
+	compiled->compiled_index[list.size()] = compiled->instructions.size();
+	ins.function = NULL;
+	ins.command = NULL;
+	ins.source_index = list.size();
+	ins.code = 0;
+	ins.indent = 0;
+	ins.param_count = 0;
+	std::fill(ins.params, ins.params + Instruction::MaxInlineParams, 0);
+	compiled->instructions.push_back(ins);
+
+	return compiled;
+}
+
+// Get command function.
+Game_Interpreter::CommandFunction Game_Interpreter::GetCommandFunction(int code) {
+	switch (code) {
 		case Cmd::ShowMessage:
-			return CommandShowMessage(com);
+			return &Game_Interpreter::CommandShowMessage;
 		case Cmd::ChangeFaceGraphic:
-			return CommandChangeFaceGraphic(com);
+			return &Game_Interpreter::CommandChangeFaceGraphic;
 		case Cmd::ShowChoice:
-			return CommandShowChoices(com);
+			return &Game_Interpreter::CommandShowChoices;
 		case Cmd::ShowChoiceOption:
-			return SkipTo(Cmd::ShowChoiceEnd);
+			return &Game_Interpreter::CommandShowChoiceOption;
 		case Cmd::ShowChoiceEnd:
-			return true;
+			return &Game_Interpreter::CommandNone;
 		case Cmd::InputNumber:
-			return CommandInputNumber(com);
-		case Cmd::ControlSwitches:
-			return CommandControlSwitches(com);
-		case Cmd::ControlVars:
-			return CommandControlVariables(com);
+			return &Game_Interpreter::CommandInputNumber;
 		case Cmd::ChangeGold:
-			return CommandChangeGold(com);
+			return &Game_Interpreter::CommandChangeGold;
 		case Cmd::ChangeItems:
-			return CommandChangeItems(com);
+			return &Game_Interpreter::CommandChangeItems;
 		case Cmd::ChangePartyMembers:
-			return CommandChangePartyMember(com);
+			return &Game_Interpreter::CommandChangePartyMember;
 		case Cmd::ChangeLevel:
-			return CommandChangeLevel(com);
+			return &Game_Interpreter::CommandChangeLevel;
 		case Cmd::ChangeSkills:
-			return CommandChangeSkills(com);
+			return &Game_Interpreter::CommandChangeSkills;
 		case Cmd::ChangeEquipment:
-			return CommandChangeEquipment(com);
+			return &Game_Interpreter::CommandChangeEquipment;
 		case Cmd::ChangeHP:
-			return CommandChangeHP(com);
+			return &Game_Interpreter::CommandChangeHP;
 		case Cmd::ChangeSP:
-			return CommandChangeSP(com);
+			return &Game_Interpreter::CommandChangeSP;
 		case Cmd::ChangeCondition:
-			return CommandChangeCondition(com);
+			return &Game_Interpreter::CommandChangeCondition;
 		case Cmd::FullHeal:
-			return CommandFullHeal(com);
+			return &Game_Interpreter::CommandFullHeal;
 		case Cmd::TintScreen:
-			return CommandTintScreen(com);
+			return &Game_Interpreter::CommandTintScreen;
 		case Cmd::FlashScreen:
-			return CommandFlashScreen(com);
+			return &Game_Interpreter::CommandFlashScreen;
 		case Cmd::ShakeScreen:
-			return CommandShakeScreen(com);
-		case Cmd::Wait:
-			return CommandWait(com);
+			return &Game_Interpreter::CommandShakeScreen;
 		case Cmd::PlayBGM:
-			return CommandPlayBGM(com);
+			return &Game_Interpreter::CommandPlayBGM;
 		case Cmd::FadeOutBGM:
-			return CommandFadeOutBGM(com);
+			return &Game_Interpreter::CommandFadeOutBGM;
 		case Cmd::PlaySound:
-			return CommandPlaySound(com);
+			return &Game_Interpreter::CommandPlaySound;
 		case Cmd::EndEventProcessing:
-			return CommandEndEventProcessing(com);
+			return &Game_Interpreter::CommandEndEventProcessing;
 		case Cmd::Comment:
 		case Cmd::Comment_2:
-			return true;
+			return &Game_Interpreter::CommandNone;
 		case Cmd::GameOver:
-			return CommandGameOver(com);
+			return &Game_Interpreter::CommandGameOver;
 		default:
-			return true;
+			return &Game_Interpreter::CommandNone;
 	}
 }
 
-bool Game_Interpreter::CommandWait(RPG::EventCommand const& com) {
-	if (com.parameters.size() <= 1 ||
-		(com.parameters.size() > 1 && com.parameters[1] == 0)) {
-		SetupWait(com.parameters[0]);
+// Get instruction function.
+Game_Interpreter::InstructionFunction Game_Interpreter::GetInstructionFunction(int code) {
+	switch (code) {
+		case Cmd::ControlSwitches:
+			return &Game_Interpreter::CommandControlSwitches;
+		case Cmd::ControlVars:
+			return &Game_Interpreter::CommandControlVariables;
+		case Cmd::Wait:
+			return &Game_Interpreter::CommandWait;
+		default:
+			return NULL;
+	}
+}
+
+bool Game_Interpreter::CommandNone(RPG::EventCommand const& /* com */) {
+	return true;
+}
+
+bool Game_Interpreter::CommandShowChoiceOption(RPG::EventCommand const& /* com */) {
+	return SkipTo(Cmd::ShowChoiceEnd);
+}
+
+bool Game_Interpreter::CommandWait(Instruction const& ins) {
+	if (ins.param_count <= 1 ||
+		(ins.param_count > 1 && ins.params[1] == 0)) {
+		SetupWait(ins.params[0]);
 		return true;
 	} else {
 		return Input::IsAnyTriggered();
@@ -533,79 +727,78 @@ bool Game_Interpreter::CommandShowChoices(RPG::EventCommand const& com) { // Cod
 }
 
 // Command control switches
-bool Game_Interpreter::CommandControlSwitches(RPG::EventCommand const& com) { // Code ControlSwitches
+bool Game_Interpreter::CommandControlSwitches(Instruction const& ins) { // Code ControlSwitches
 	int i;
-	switch (com.parameters[0]) {
+	switch (ins.params[0]) {
 		case 0:
 		case 1:
 			// Single and switch range
-			for (i = com.parameters[1]; i <= com.parameters[2]; i++) {
-				if (com.parameters[3] != 2) {
-					Game_Switches[i] = com.parameters[3] == 0;
+			for (i = ins.params[1]; i <= ins.params[2]; i++) {
+				if (ins.params[3] != 2) {
+					Game_Switches.Set(i, ins.params[3] == 0);
 				} else {
-					Game_Switches[i] = !Game_Switches[i];
+					Game_Switches.Set(i, !Game_Switches[i]);
 				}
 			}
 			break;
 		case 2:
 			// Switch from variable
-			if (com.parameters[3] != 2) {
-				Game_Switches[Game_Variables[com.parameters[1]]] = com.parameters[3] == 0;
+			if (ins.params[3] != 2) {
+				Game_Switches.Set(Game_Variables[ins.params[1]], ins.params[3] == 0);
 			} else {
-				Game_Switches[Game_Variables[com.parameters[1]]] = !Game_Switches[Game_Variables[com.parameters[1]]];
+				Game_Switches.Set(Game_Variables[ins.params[1]], !Game_Switches[Game_Variables[ins.params[1]]]);
 			}
 			break;
 		default:
 			return false;
 	}
-	Game_Map::SetNeedRefresh(true);
 	return true;
 }
 
 // Command control vars
-bool Game_Interpreter::CommandControlVariables(RPG::EventCommand const& com) { // Code ControlVars
+bool Game_Interpreter::CommandControlVariables(Instruction const& ins) { // Code ControlVars
 	int i, value = 0;
 	Game_Actor* actor;
 	Game_Character* character;
 
-	switch (com.parameters[4]) {
+	switch (ins.params[4]) {
 		case 0:
 			// Constant
-			value = com.parameters[5];
+			value = ins.params[5];
 			break;
 		case 1:
 			// Var A ops B
-			value = Game_Variables[com.parameters[5]];
+			value = Game_Variables[ins.params[5]];
 			break;
 		case 2:
 			// Number of var A ops B
-			value = Game_Variables[Game_Variables[com.parameters[5]]];
+			value = Game_Variables[Game_Variables[ins.params[5]]];
 			break;
 		case 3:
 			// Random between range
 			int a, b;
-			a = max(com.parameters[5], com.parameters[6]);
-			b = min(com.parameters[5], com.parameters[6]);
+			a = max(ins.params[5], ins.params[6]);
+			b = min(ins.params[5], ins.params[6]);
 			value = rand() % (a-b+1)+b;
 			break;
 		case 4:
 			// Items
-			switch (com.parameters[6]) {
+			switch (ins.params[6]) {
 				case 0:
 					// Number of items posessed
-					value = Main_Data::game_party->GetItemCount(com.parameters[5]);
+					value = Main_Data::game_party->GetItemCount(ins.params[5]);
 					break;
 				case 1:
 					// How often the item is equipped
-					value = Main_Data::game_party->GetItemCount(com.parameters[5], true);
+					value = Main_Data::game_party->GetItemCount(ins.params[5], true);
 					break;
 			}
 			break;
 		case 5:
 			// Hero
-			actor = Game_Actors::GetActor(com.parameters[5]);
+			actor = Game_Actors::GetActor(ins.params[5]);
 			if (actor != NULL) {
-				switch (com.parameters[6]) {
+				switch (ins.params[6]) {
 					case 0:
 						// Level
 						value = actor->GetLevel();
@@ -671,9 +864,9 @@ bool Game_Interpreter::CommandControlVariables(RPG::EventCommand const& com) { /
 			break;
 		case 6:
 			// Characters
-			character = GetCharacter(com.parameters[5]);
+			character = GetCharacter(ins.params[5]);
 			if (character != NULL) {
-				switch (com.parameters[6]) {
+				switch (ins.params[6]) {
 					case 0:
 						// Map ID
 						value = character->GetMapId();
@@ -706,7 +899,7 @@ bool Game_Interpreter::CommandControlVariables(RPG::EventCommand const& com) { /
 			break;
 		case 7:
 			// More
-			switch (com.parameters[5]) {
+			switch (ins.params[5]) {
 				case 0:
 					// Gold
 					value = Main_Data::game_party->GetGold();
@@ -750,91 +943,94 @@ bool Game_Interpreter::CommandControlVariables(RPG::EventCommand const& com) { /
 			;
 	}
 
-	switch (com.parameters[0]) {
+	switch (ins.params[0]) {
 		case 0:
 		case 1:
 			// Single and Var range
-			for (i = com.parameters[1]; i <= com.parameters[2]; i++) {
-				switch (com.parameters[3]) {
+			for (i = ins.params[1]; i <= ins.params[2]; i++) {
+				int result = Game_Variables[i];
+				switch (ins.params[3]) {
 					case 0:
 						// Assignement
-						Game_Variables[i] = value;
+						result = value;
 						break;
 					case 1:
 						// Addition
-						Game_Variables[i] += value;
+						result += value;
 						break;
 					case 2:
 						// Subtraction
-						Game_Variables[i] -= value;
+						result -= value;
 						break;
 					case 3:
 						// Multiplication
-						Game_Variables[i] *= value;
+						result *= value;
 						break;
 					case 4:
 						// Division
 						if (value != 0) {
-							Game_Variables[i] /= value;
+							result /= value;
 						}
 						break;
 					case 5:
 						// Module
 						if (value != 0) {
-							Game_Variables[i] %= value;
+							result %= value;
 						} else {
-							Game_Variables[i] = 0;
+							result = 0;
 						}
 				}
-				if (Game_Variables[i] > MaxSize) {
-					Game_Variables[i] = MaxSize;
+				if (result > MaxSize) {
+					result = MaxSize;
 				}
-				if (Game_Variables[i] < MinSize) {
-					Game_Variables[i] = MinSize;
+				if (result < MinSize) {
+					result = MinSize;
 				}
+				Game_Variables.Set(i, result);
 			}
 			break;
 
 		case 2:
-			int var_index = Game_Variables[com.parameters[1]];
-			switch (com.parameters[3]) {
+			int var_index = Game_Variables[ins.params[1]];
+			int result = Game_Variables[var_index];
+			switch (ins.params[3]) {
 				case 0:
 					// Assignement
-					Game_Variables[var_index] = value;
+					result = value;
 					break;
 				case 1:
 					// Addition
-					Game_Variables[var_index] += value;
+					result += value;
 					break;
 				case 2:
 					// Subtraction
-					Game_Variables[var_index] -= value;
+					result -= value;
 					break;
 				case 3:
 					// Multiplication
-					Game_Variables[var_index] *= value;
+					result *= value;
 					break;
 				case 4:
 					// Division
 					if (value != 0) {
-						Game_Variables[var_index] /= value;
+						result /= value;
 					}
 					break;
 				case 5:
 					// Module
 					if (value != 0) {
-						Game_Variables[var_index] %= value;
+						result %= value;
 					}
 			}
-			if (Game_Variables[var_index] > MaxSize) {
-				Game_Variables[var_index] = MaxSize;
+			if (result > MaxSize) {
+				result = MaxSize;
 			}
-			if (Game_Variables[var_index] < MinSize) {
-				Game_Variables[var_index] = MinSize;
+			if (result < MinSize) {
+				result = MinSize;
 			}
+			Game_Variables.Set(var_index, result);
 	}
 
-	Game_Map::SetNeedRefresh(true);
 	return true;
 }
 
@@ -902,6 +1098,7 @@ bool Game_Interpreter::CommandChangeGold(RPG::EventCommand const& com) { // Code
 
 // Change Items.
 bool Game_Interpreter::CommandChangeItems(RPG::EventCommand const& com) { // Code 10320
+	int item_id;
 	int value;
 	value = OperateValue(
 		com.parameters[0],
@@ -925,15 +1122,12 @@ bool Game_Interpreter::CommandChangeItems(RPG::EventCommand const& com) { // Cod
 
 	if (com.parameters[1] == 0) {
 		// Item by const number
-		Main_Data::game_party->AddItem(com.parameters[2], value);
+		item_id = com.parameters[2];
 	} else {
 		// Item by variable
-		Main_Data::game_party->AddItem(
-			Game_Variables[com.parameters[2]],
-			value
-		);
+		item_id = Game_Variables[com.parameters[2]];
 	}
-	Game_Map::SetNeedRefresh(true);
+	Main_Data::game_party->AddItem(item_id, value);
 	// Continue
 	return true;
 }
@@ -992,8 +1186,6 @@ bool Game_Interpreter::CommandChangePartyMember(RPG::EventCommand const& com) {
 		}
 	}
 
-	Game_Map::SetNeedRefresh(true);
-
 	// Continue
 	return true;
 }
@@ -26,6 +26,7 @@
 #include "rpg_eventcommand.h"
 #include "system.h"
 #include "command_codes.h"
+#include "jump_table.h"
 #include <boost/scoped_ptr.hpp>
 
 class Game_Event;
@@ -41,11 +42,21 @@ public:
 	virtual ~Game_Interpreter();
 
 	void Clear();
-	void Setup(const std::vector<RPG::EventCommand>& _list, int _event_id, int dbg_x = -1, int dbg_y = -1);
+	void Setup(const std::vector<RPG::EventCommand>& _list, int _event_id, int dbg_x = -1, int dbg_y = -1, int _common_event_id = 0);
 
 	bool IsRunning() const;
 	void Update();
 
+	/**
+	 * Checks whether Update would only keep waiting, for a wait command
+	 * or for a transition. Owners skip Update of parked interpreters,
+	 * skipped frames still count towards the wait. Any shown message
+	 * wakes the interpreter because it can pause the wait.
+	 *
+	 * @return whether Update can be skipped this frame.
+	 */
+	bool IsParked() const;
+
 	void SetupStartingEvent(Game_Event* ev);
 	void SetupStartingEvent(Game_CommonEvent* ev);
 	void InputButton();
@@ -59,6 +70,12 @@ public:
 		MinSize = -9999999
 	};
 
+	/**
+	 * Forgets the cached jump tables and compiled lists.
+	 * Called when the map events and their command lists are replaced.
+	 */
+	static void ClearTableCaches();
+
 protected:
 	friend class Game_Interpreter_Map;
 
@@ -72,14 +89,99 @@ protected:
 	unsigned int index;
 	int map_id;
 	unsigned int event_id;
+	/** ID of the common event being run, 0 for map and battle events. */
+	int common_event_id;
 	int wait_count;
 
+	/** Why the last Update stopped executing commands. */
+	enum BlockReason {
+		BlockNone,
+		/** Counting down wait_count */
+		BlockWait,
+		/** A screen transition is running */
+		BlockTransition
+	};
+
+	/** Set when Update stops on a condition the interpreter can be parked on. */
+	BlockReason block_reason;
+	/** Game_Map update count when the wait blocked the interpreter. */
+	int block_frame;
+
 	boost::scoped_ptr<Game_Interpreter> child_interpreter;
 	typedef bool (Game_Interpreter::*ContinuationFunction)(RPG::EventCommand const& com);
 	ContinuationFunction continuation;
 
 	std::vector<RPG::EventCommand> list;
 
+	struct Instruction;
+	typedef bool (Game_Interpreter::*CommandFunction)(RPG::EventCommand const& com);
+	typedef bool (Game_Interpreter::*InstructionFunction)(Instruction const& ins);
+
+	/**
+	 * Command of a compiled list. The parameters are stored inline, so
+	 * instruction functions don't touch the source command.
+	 */
+	struct Instruction {
+		enum { MaxInlineParams = 8 };
+
+		/** Function running the instruction, NULL for the end of the list. */
+		InstructionFunction function;
+		/** Source command function, run by RunCommand. */
+		CommandFunction command;
+		/** Index of the command in the source list. */
+		int source_index;
+		int code;
+		int indent;
+		/** Number of source parameters, params holds the first MaxInlineParams. */
+		int param_count;
+		/** Parameters, padded with 0. */
+		int params[MaxInlineParams];
+	};
+
+	/**
+	 * Event command list lowered to instructions. Commands without an
+	 * effect are left out, the interpreter index stays a source index.
+	 */
+	struct CompiledList {
+		/** Instructions in source order, ending with an end of list instruction. */
+		std::vector<Instruction> instructions;
+		/**
+		 * Instruction index of every source index and of the list end.
+		 * Left out commands map to the next instruction.
+		 */
+		std::vector<int> compiled_index;
+	};
+	typedef EASYRPG_SHARED_PTR<const CompiledList> CompiledListRef;
+
+	/**
+	 * Compiled lists of the lists run by one interpreter class.
+	 * Keyed by the command list Setup receives, like the jump tables.
+	 */
+	class CompiledListCache {
+	public:
+		CompiledListCache();
+
+		/**
+		 * Gets the compiled list of a list, compiling it on the first request.
+		 *
+		 * @param interpreter interpreter resolving the functions.
+		 * @param list event commands.
+		 * @return compiled list.
+		 */
+		CompiledListRef Get(Game_Interpreter& interpreter, const std::vector<RPG::EventCommand>& list);
+
+	private:
+		std::map<const std::vector<RPG::EventCommand>*, CompiledListRef> lists;
+		/** Lists are dropped when ClearTableCaches was called meanwhile. */
+		int generation;
+	};
+
+	/** Compiled form of list, shared like jump_table. */
+	CompiledListRef compiled_list;
+
+	/** Jump table of list, shared with all interpreters running the same list. */
+	JumpTableRef jump_table;
+
 	int button_timer;
 	bool active;
 	bool updating;
@@ -102,11 +204,33 @@ protected:
 	int OperateValue(int operation, int operand_type, int operand);
 	Game_Character* GetCharacter(int character_id);
 
+	/**
+	 * Gets the jump table of the current command list.
+	 *
+	 * @return jump table.
+	 */
+	const JumpTable& GetJumpTable();
+
 	bool SkipTo(int code, int code2 = -1, int min_indent = -1, int max_indent = -1, bool otherwise_end = false);
 	void SetContinuation(ContinuationFunction func);
 
 	void CancelMenuCall();
 
+	/**
+	 * Checks whether a message blocks the interpreter.
+	 *
+	 * @return whether commands must wait for the message.
+	 */
+	bool IsMessageBlocking() const;
+
+	/**
+	 * Gets the frames left to wait, including the frames skipped while
+	 * the interpreter was parked.
+	 *
+	 * @return remaining wait frames.
+	 */
+	int GetWaitCount() const;
+
 	/**
 	 * Sets up a wait (and closes the message box)
 	 */
@@ -131,12 +255,65 @@ protected:
 	 */
 	void CloseMessageWindow();
 
+	/**
+	 * Gets the function executing an event command.
+	 * Only used for commands without an instruction function.
+	 *
+	 * @param code command code.
+	 * @return command function, CommandNone for commands without effect.
+	 */
+	virtual CommandFunction GetCommandFunction(int code);
+
+	/**
+	 * Gets the function executing a compiled command, which reads the
+	 * inline parameters instead of the source command.
+	 *
+	 * @param code command code.
+	 * @return instruction function, NULL when the command is run from
+	 *         the source list.
+	 */
+	virtual InstructionFunction GetInstructionFunction(int code);
+
+	/**
+	 * Gets the compiled list cache of the interpreter class.
+	 * Every class overriding GetCommandFunction or GetInstructionFunction
+	 * needs its own cache.
+	 *
+	 * @return compiled list cache.
+	 */
+	virtual CompiledListCache& GetCompiledListCache();
+
+	/**
+	 * Compiles a list to instructions.
+	 *
+	 * @param list event commands.
+	 * @return compiled list.
+	 */
+	CompiledListRef Compile(const std::vector<RPG::EventCommand>& list);
+
+	/**
+	 * Gets the compiled form of the current command list.
+	 *
+	 * @return compiled list.
+	 */
+	const CompiledList& GetCompiledList();
+
+	/**
+	 * Runs the source command of an instruction without instruction function.
+	 *
+	 * @param ins instruction of the current command.
+	 * @return result of the command function.
+	 */
+	bool RunCommand(Instruction const& ins);
+
+	bool CommandNone(RPG::EventCommand const& com);
 	bool CommandShowMessage(RPG::EventCommand const& com);
 	bool CommandChangeFaceGraphic(RPG::EventCommand const& com);
 	bool CommandShowChoices(RPG::EventCommand const& com);
+	bool CommandShowChoiceOption(RPG::EventCommand const& com);
 	bool CommandInputNumber(RPG::EventCommand const& com);
-	bool CommandControlSwitches(RPG::EventCommand const& com);
-	bool CommandControlVariables(RPG::EventCommand const& com);
+	bool CommandControlSwitches(Instruction const& ins);
+	bool CommandControlVariables(Instruction const& ins);
 	bool CommandChangeGold(RPG::EventCommand const& com);
 	bool CommandChangeItems(RPG::EventCommand const& com);
 	bool CommandChangePartyMember(RPG::EventCommand const& com);
@@ -150,7 +327,7 @@ protected:
 	bool CommandTintScreen(RPG::EventCommand const& com);
 	bool CommandFlashScreen(RPG::EventCommand const& com);
 	bool CommandShakeScreen(RPG::EventCommand const& com);
-	bool CommandWait(RPG::EventCommand const& com);
+	bool CommandWait(Instruction const& ins);
 	bool CommandPlayBGM(RPG::EventCommand const& com);
 	bool CommandFadeOutBGM(RPG::EventCommand const& com);
 	bool CommandPlaySound(RPG::EventCommand const& com);
@@ -41,41 +41,59 @@ bool Game_Interpreter_Battle::ExecuteCommand() {
 	if (Main_Data::game_screen->IsBattleAnimationWaiting()) {
 		return false;
 	}
-	
-	RPG::EventCommand const& com = list[index];
 
-	switch (com.code) {
+	return Game_Interpreter::ExecuteCommand();
+}
+
+Game_Interpreter::CompiledListCache& Game_Interpreter_Battle::GetCompiledListCache() {
+	static CompiledListCache cache;
+	return cache;
+}
+
+Game_Interpreter::CommandFunction Game_Interpreter_Battle::GetCommandFunction(int code) {
+	switch (code) {
 		case Cmd::CallCommonEvent:
-			return CommandCallCommonEvent(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Battle::CommandCallCommonEvent);
 		case Cmd::ForceFlee:
-			return CommandForceFlee(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Battle::CommandForceFlee);
 		case Cmd::EnableCombo:
-			return CommandEnableCombo(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Battle::CommandEnableCombo);
 		case Cmd::ChangeMonsterHP:
-			return CommandChangeMonsterHP(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Battle::CommandChangeMonsterHP);
 		case Cmd::ChangeMonsterMP:
-			return CommandChangeMonsterMP(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Battle::CommandChangeMonsterMP);
 		case Cmd::ChangeMonsterCondition:
-			return CommandChangeMonsterCondition(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Battle::CommandChangeMonsterCondition);
 		case Cmd::ShowHiddenMonster:
-			return CommandShowHiddenMonster(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Battle::CommandShowHiddenMonster);
 		case Cmd::ChangeBattleBG:
-			return CommandChangeBattleBG(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Battle::CommandChangeBattleBG);
 		case Cmd::ShowBattleAnimation_B:
-			return CommandShowBattleAnimation(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Battle::CommandShowBattleAnimation);
 		case Cmd::TerminateBattle:
-			return CommandTerminateBattle(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Battle::CommandTerminateBattle);
+		case Cmd::EndBranch_B:
+			return static_cast<CommandFunction>(&Game_Interpreter_Battle::CommandNone);
+		default:
+			return Game_Interpreter::GetCommandFunction(code);
+	}
+}
+
+Game_Interpreter::InstructionFunction Game_Interpreter_Battle::GetInstructionFunction(int code) {
+	switch (code) {
 		case Cmd::ConditionalBranch_B:
-			return CommandConditionalBranch(com);
+			return static_cast<InstructionFunction>(&Game_Interpreter_Battle::CommandConditionalBranch);
 		case Cmd::ElseBranch_B:
-			return SkipTo(Cmd::EndBranch_B);
-		case Cmd::EndBranch_B:
-			return true;
+			return static_cast<InstructionFunction>(&Game_Interpreter_Battle::CommandElseBranch);
 		default:
-			return Game_Interpreter::ExecuteCommand();
+			return Game_Interpreter::GetInstructionFunction(code);
 	}
 }
 
+bool Game_Interpreter_Battle::CommandElseBranch(Instruction const& /* ins */) {
+	return SkipTo(Cmd::EndBranch_B);
+}
+
 // Commands
 
 bool Game_Interpreter_Battle::CommandCallCommonEvent(RPG::EventCommand const& com) {
@@ -87,7 +105,7 @@ bool Game_Interpreter_Battle::CommandCallCommonEvent(RPG::EventCommand const& co
 	const RPG::CommonEvent& event = Data::commonevents[event_id - 1];
 
 	child_interpreter.reset(new Game_Interpreter_Battle(depth + 1));
-	child_interpreter->Setup(event.event_commands, 0, event.ID, -2);
+	child_interpreter->Setup(event.event_commands, 0, event.ID, -2, event.ID);
 
 	return true;
 }
@@ -252,24 +270,24 @@ bool Game_Interpreter_Battle::CommandTerminateBattle(RPG::EventCommand const& /*
 }
 
 // Conditional branch.
-bool Game_Interpreter_Battle::CommandConditionalBranch(RPG::EventCommand const& com) {
+bool Game_Interpreter_Battle::CommandConditionalBranch(Instruction const& ins) {
 	bool result = false;
 	int value1, value2;
 
-	switch (com.parameters[0]) {
+	switch (ins.params[0]) {
 		case 0:
 			// Switch
-			result = Game_Switches[com.parameters[1]] == (com.parameters[2] == 0);
+			result = Game_Switches[ins.params[1]] == (ins.params[2] == 0);
 			break;
 		case 1:
 			// Variable
-			value1 = Game_Variables[com.parameters[1]];
-			if (com.parameters[2] == 0) {
-				value2 = com.parameters[3];
+			value1 = Game_Variables[ins.params[1]];
+			if (ins.params[2] == 0) {
+				value2 = ins.params[3];
 			} else {
-				value2 = Game_Variables[com.parameters[3]];
+				value2 = Game_Variables[ins.params[3]];
 			}
-			switch (com.parameters[4]) {
+			switch (ins.params[4]) {
 				case 0:
 					// Equal to
 					result = (value1 == value2);
@@ -298,7 +316,7 @@ bool Game_Interpreter_Battle::CommandConditionalBranch(RPG::EventCommand const&
 			break;
 		case 2: {
 			// Hero can act
-			Game_Actor* actor = Game_Actors::GetActor(com.parameters[1]);
+			Game_Actor* actor = Game_Actors::GetActor(ins.params[1]);
 			if (actor) {
 				result = actor->CanAct();
 			}
@@ -306,21 +324,21 @@ bool Game_Interpreter_Battle::CommandConditionalBranch(RPG::EventCommand const&
 		}
 		case 3:
 			// Monster can act
-			if (com.parameters[1] < Main_Data::game_enemyparty->GetBattlerCount()) {
-				result = (*Main_Data::game_enemyparty)[com.parameters[1]].CanAct();
+			if (ins.params[1] < Main_Data::game_enemyparty->GetBattlerCount()) {
+				result = (*Main_Data::game_enemyparty)[ins.params[1]].CanAct();
 			}
 			break;
 		case 4:
 			Output::Warning("Battle: Monster is target not implemented");
 			// Monster is the current target
 			/*result = Game_Battle::HaveTargetEnemy() &&
-				Game_Battle::GetTargetEnemy().ID == com.parameters[1];*/
+				Game_Battle::GetTargetEnemy().ID == ins.params[1];*/
 			break;
 		case 5:
 			Output::Warning("Battle: Hero uses command X not implemented");
 			// Hero uses the ... command
-			/*ally = Game_Battle::FindAlly(com.parameters[1]);
-			result = (ally != NULL && ally->last_command == com.parameters[2]);*/
+			/*ally = Game_Battle::FindAlly(ins.params[1]);
+			result = (ally != NULL && ally->last_command == ins.params[2]);*/
 			break;
 	}
 
@@ -40,6 +40,10 @@ public:
 
 	bool ExecuteCommand();
 private:
+	CommandFunction GetCommandFunction(int code);
+	InstructionFunction GetInstructionFunction(int code);
+	CompiledListCache& GetCompiledListCache();
+
 	bool CommandCallCommonEvent(RPG::EventCommand const& com);
 	bool CommandForceFlee(RPG::EventCommand const& com);
 	bool CommandEnableCombo(RPG::EventCommand const& com);
@@ -50,7 +54,8 @@ private:
 	bool CommandChangeBattleBG(RPG::EventCommand const& com);
 	bool CommandShowBattleAnimation(RPG::EventCommand const& com);
 	bool CommandTerminateBattle(RPG::EventCommand const& com);
-	bool CommandConditionalBranch(RPG::EventCommand const& com);
+	bool CommandConditionalBranch(Instruction const& ins);
+	bool CommandElseBranch(Instruction const& ins);
 };
 
 #endif
@@ -64,6 +64,9 @@ bool Game_Interpreter_Map::SetupFromSave(const std::vector<RPG::SaveEventCommand
 		map_id = Game_Map::GetMapId();
 		event_id = _event_id;
 		list = save[_index].commands;
+		jump_table.reset();
+		compiled_list.reset();
+		block_reason = BlockNone;
 		index = save[_index].current_command;
 
 		child_interpreter.reset(new Game_Interpreter_Map());
@@ -185,168 +188,198 @@ bool Game_Interpreter_Map::ExecuteCommand() {
 		return CommandEnd();
 	}
 
-	RPG::EventCommand const& com = list[index];
+	return Game_Interpreter::ExecuteCommand();
+}
+
+Game_Interpreter::CompiledListCache& Game_Interpreter_Map::GetCompiledListCache() {
+	static CompiledListCache cache;
+	return cache;
+}
 
-	switch (com.code) {
+Game_Interpreter::CommandFunction Game_Interpreter_Map::GetCommandFunction(int code) {
+	switch (code) {
 		case Cmd::MessageOptions:
-			return CommandMessageOptions(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandMessageOptions);
 		case Cmd::ChangeExp:
-			return CommandChangeExp(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeExp);
 		case Cmd::ChangeParameters:
-			return CommandChangeParameters(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeParameters);
 		case Cmd::ChangeHeroName:
-			return CommandChangeHeroName(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeHeroName);
 		case Cmd::ChangeHeroTitle:
-			return CommandChangeHeroTitle(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeHeroTitle);
 		case Cmd::ChangeSpriteAssociation:
-			return CommandChangeSpriteAssociation(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeSpriteAssociation);
 		case Cmd::MemorizeLocation:
-			return CommandMemorizeLocation(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandMemorizeLocation);
 		case Cmd::RecallToLocation:
-			return CommandRecallToLocation(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandRecallToLocation);
 		case Cmd::StoreTerrainID:
-			return CommandStoreTerrainID(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandStoreTerrainID);
 		case Cmd::StoreEventID:
-			return CommandStoreEventID(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandStoreEventID);
 		case Cmd::MemorizeBGM:
-			return CommandMemorizeBGM(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandMemorizeBGM);
 		case Cmd::PlayMemorizedBGM:
-			return CommandPlayMemorizedBGM(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandPlayMemorizedBGM);
 		case Cmd::ChangeSystemBGM:
-			return CommandChangeSystemBGM(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeSystemBGM);
 		case Cmd::ChangeSystemSFX:
-			return CommandChangeSystemSFX(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeSystemSFX);
 		case Cmd::ChangeSaveAccess:
-			return CommandChangeSaveAccess(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeSaveAccess);
 		case Cmd::ChangeTeleportAccess:
-			return CommandChangeTeleportAccess(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeTeleportAccess);
 		case Cmd::ChangeEscapeAccess:
-			return CommandChangeEscapeAccess(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeEscapeAccess);
 		case Cmd::ChangeMainMenuAccess:
-			return CommandChangeMainMenuAccess(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeMainMenuAccess);
 		case Cmd::ChangeActorFace:
-			return CommandChangeActorFace(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeActorFace);
 		case Cmd::Teleport:
-			return CommandTeleport(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandTeleport);
 		case Cmd::EraseScreen:
-			return CommandEraseScreen(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandEraseScreen);
 		case Cmd::ShowScreen:
-			return CommandShowScreen(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandShowScreen);
 		case Cmd::ShowPicture:
-			return CommandShowPicture(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandShowPicture);
 		case Cmd::MovePicture:
-			return CommandMovePicture(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandMovePicture);
 		case Cmd::ErasePicture:
-			return CommandErasePicture(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandErasePicture);
 		case Cmd::WeatherEffects:
-			return CommandWeatherEffects(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandWeatherEffects);
 		case Cmd::ChangeSystemGraphics:
-			return CommandChangeSystemGraphics(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeSystemGraphics);
 		case Cmd::ChangeScreenTransitions:
-			return CommandChangeScreenTransitions(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeScreenTransitions);
 		case Cmd::ChangeEventLocation:
-			return CommandChangeEventLocation(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeEventLocation);
 		case Cmd::TradeEventLocations:
-			return CommandTradeEventLocations(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandTradeEventLocations);
 		case Cmd::TimerOperation:
-			return CommandTimerOperation(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandTimerOperation);
 		case Cmd::ChangePBG:
-			return CommandChangePBG(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangePBG);
 		case Cmd::Label:
-			return true;
-		case Cmd::JumpToLabel:
-			return CommandJumpToLabel(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandNone);
 		case Cmd::Loop:
-			return true;
-		case Cmd::BreakLoop:
-			return CommandBreakLoop(com);
-		case Cmd::EndLoop:
-			return CommandEndLoop(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandNone);
 		case Cmd::MoveEvent:
-			return CommandMoveEvent(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandMoveEvent);
 		case Cmd::OpenShop:
-			return CommandOpenShop(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandOpenShop);
 		case Cmd::Transaction:
 		case Cmd::NoTransaction:
-			return SkipTo(Cmd::EndShop);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandTransaction);
 		case Cmd::EndShop:
-			return true;
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandNone);
 		case Cmd::ShowInn:
-			return CommandShowInn(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandShowInn);
 		case Cmd::Stay:
 		case Cmd::NoStay:
-			return SkipTo(Cmd::EndInn);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandStay);
 		case Cmd::EndInn:
-			return true;
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandNone);
 		case Cmd::EnterHeroName:
-			return CommandEnterHeroName(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandEnterHeroName);
 		case Cmd::ReturntoTitleScreen:
-			return CommandReturnToTitleScreen(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandReturnToTitleScreen);
 		case Cmd::OpenSaveMenu:
-			return CommandOpenSaveMenu(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandOpenSaveMenu);
 		case Cmd::OpenMainMenu:
-			return CommandOpenMainMenu(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandOpenMainMenu);
 		case Cmd::EnemyEncounter:
-			return CommandEnemyEncounter(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandEnemyEncounter);
 		case Cmd::VictoryHandler:
 		case Cmd::EscapeHandler:
 		case Cmd::DefeatHandler:
-			return SkipTo(Cmd::EndBattle);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandBattleHandler);
 		case Cmd::EndBattle:
-			return true;
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandNone);
 		case Cmd::TeleportTargets:
-			return CommandTeleportTargets(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandTeleportTargets);
 		case Cmd::EscapeTarget:
-			return CommandEscapeTarget(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandEscapeTarget);
 		case Cmd::SpriteTransparency:
-			return CommandSpriteTransparency(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandSpriteTransparency);
 		case Cmd::FlashSprite:
-			return CommandFlashSprite(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandFlashSprite);
 		case Cmd::EraseEvent:
-			return CommandEraseEvent(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandEraseEvent);
 		case Cmd::ChangeMapTileset:
-			return CommandChangeMapTileset(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeMapTileset);
 		case Cmd::CallEvent:
-			return CommandCallEvent(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandCallEvent);
 		case Cmd::ChangeEncounterRate:
-			return CommandChangeEncounterRate(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeEncounterRate);
 		case Cmd::ProceedWithMovement:
-			return CommandProceedWithMovement(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandProceedWithMovement);
 		case Cmd::PlayMovie:
-			return CommandPlayMovie(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandPlayMovie);
 		case Cmd::ChangeBattleCommands:
-			return CommandChangeBattleCommands(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeBattleCommands);
 		case Cmd::KeyInputProc:
-			return CommandKeyInputProc(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandKeyInputProc);
 		case Cmd::ChangeVehicleGraphic:
-			return CommandChangeVehicleGraphic(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeVehicleGraphic);
 		case Cmd::EnterExitVehicle:
-			return CommandEnterExitVehicle(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandEnterExitVehicle);
 		case Cmd::SetVehicleLocation:
-			return CommandSetVehicleLocation(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandSetVehicleLocation);
 		case Cmd::TileSubstitution:
-			return CommandTileSubstitution(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandTileSubstitution);
 		case Cmd::PanScreen:
-			return CommandPanScreen(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandPanScreen);
 		case Cmd::SimulatedAttack:
-			return CommandSimulatedAttack(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandSimulatedAttack);
 		case Cmd::ShowBattleAnimation:
-			return CommandShowBattleAnimation(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandShowBattleAnimation);
 		case Cmd::ChangeClass:
-			return CommandChangeClass(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandChangeClass);
 		case Cmd::HaltAllMovement:
-			return CommandHaltAllMovement(com);
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandHaltAllMovement);
+		case Cmd::EndBranch:
+			return static_cast<CommandFunction>(&Game_Interpreter_Map::CommandNone);
+		default:
+			return Game_Interpreter::GetCommandFunction(code);
+	}
+}
+
+Game_Interpreter::InstructionFunction Game_Interpreter_Map::GetInstructionFunction(int code) {
+	switch (code) {
+		case Cmd::JumpToLabel:
+			return static_cast<InstructionFunction>(&Game_Interpreter_Map::CommandJumpToLabel);
+		case Cmd::BreakLoop:
+			return static_cast<InstructionFunction>(&Game_Interpreter_Map::CommandBreakLoop);
+		case Cmd::EndLoop:
+			return static_cast<InstructionFunction>(&Game_Interpreter_Map::CommandEndLoop);
 		case Cmd::ConditionalBranch:
-			return CommandConditionalBranch(com);
+			return static_cast<InstructionFunction>(&Game_Interpreter_Map::CommandConditionalBranch);
 		case Cmd::ElseBranch:
-			return SkipTo(Cmd::EndBranch);
-		case Cmd::EndBranch:
-			return true;
+			return static_cast<InstructionFunction>(&Game_Interpreter_Map::CommandElseBranch);
 		default:
-			return Game_Interpreter::ExecuteCommand();
+			return Game_Interpreter::GetInstructionFunction(code);
 	}
 }
 
+bool Game_Interpreter_Map::CommandTransaction(RPG::EventCommand const& /* com */) {
+	return SkipTo(Cmd::EndShop);
+}
+
+bool Game_Interpreter_Map::CommandStay(RPG::EventCommand const& /* com */) {
+	return SkipTo(Cmd::EndInn);
+}
+
+bool Game_Interpreter_Map::CommandBattleHandler(RPG::EventCommand const& /* com */) {
+	return SkipTo(Cmd::EndBattle);
+}
+
+bool Game_Interpreter_Map::CommandElseBranch(Instruction const& /* ins */) {
+	return SkipTo(Cmd::EndBranch);
+}
+
 /**
  * Commands
  */
@@ -964,40 +997,24 @@ bool Game_Interpreter_Map::CommandChangePBG(RPG::EventCommand const& com) { // c
 	return true;
 }
 
-bool Game_Interpreter_Map::CommandJumpToLabel(RPG::EventCommand const& com) { // code 12120
-	int label_id = com.parameters[0];
-
-	for (int idx = 0; (size_t) idx < list.size(); idx++) {
-		if (list[idx].code != Cmd::Label)
-			continue;
-		if (list[idx].parameters[0] != label_id)
-			continue;
+bool Game_Interpreter_Map::CommandJumpToLabel(Instruction const& ins) { // code 12120
+	int idx = GetJumpTable().FindLabel(ins.params[0]);
+	if (idx >= 0) {
 		index = idx;
-		break;
 	}
 
 	return true;
 }
 
-bool Game_Interpreter_Map::CommandBreakLoop(RPG::EventCommand const& com) { // code 12220
-	return SkipTo(Cmd::EndLoop, Cmd::EndLoop, 0, com.indent - 1, true);
+bool Game_Interpreter_Map::CommandBreakLoop(Instruction const& ins) { // code 12220
+	return SkipTo(Cmd::EndLoop, Cmd::EndLoop, 0, ins.indent - 1, true);
 }
 
-bool Game_Interpreter_Map::CommandEndLoop(RPG::EventCommand const& com) { // code 22210
-	int indent = com.indent;
-
-	for (int idx = index; idx >= 0; idx--) {
-		if (list[idx].indent > indent)
-			continue;
-		if (list[idx].indent < indent)
-			return false;
-		if (list[idx].code != Cmd::Loop)
-			continue;
-		index = idx;
-		break;
-	}
-
-	return true;
+bool Game_Interpreter_Map::CommandEndLoop(Instruction const& /* ins */) { // code 22210
+	int idx = index;
+	bool const result = GetJumpTable().FindLoop(idx);
+	index = idx;
+	return result;
 }
 
 bool Game_Interpreter_Map::CommandMoveEvent(RPG::EventCommand const& com) { // code 11330
@@ -1410,7 +1427,7 @@ bool Game_Interpreter_Map::CommandCallEvent(RPG::EventCommand const& com) { // c
 	switch (com.parameters[0]) {
 		case 0: // Common Event
 			evt_id = com.parameters[1];
-			child_interpreter->Setup(Data::commonevents[evt_id - 1].event_commands, event_id, Data::commonevents[evt_id - 1].ID, -2);
+			child_interpreter->Setup(Data::commonevents[evt_id - 1].event_commands, event_id, Data::commonevents[evt_id - 1].ID, -2, Data::commonevents[evt_id - 1].ID);
 			return true;
 		case 1: // Map Event
 			evt_id = com.parameters[1];
@@ -1810,27 +1827,27 @@ bool Game_Interpreter_Map::CommandHaltAllMovement(RPG::EventCommand const& /* co
 /**
  * Conditional Branch
  */
-bool Game_Interpreter_Map::CommandConditionalBranch(RPG::EventCommand const& com) { // Code 12010
+bool Game_Interpreter_Map::CommandConditionalBranch(Instruction const& ins) { // Code 12010
 	bool result = false;
 	int value1, value2;
 	int actor_id;
 	Game_Actor* actor;
 	Game_Character* character;
 
-	switch (com.parameters[0]) {
+	switch (ins.params[0]) {
 		case 0:
 			// Switch
-			result = Game_Switches[com.parameters[1]] == (com.parameters[2] == 0);
+			result = Game_Switches[ins.params[1]] == (ins.params[2] == 0);
 			break;
 		case 1:
 			// Variable
-			value1 = Game_Variables[com.parameters[1]];
-			if (com.parameters[2] == 0) {
-				value2 = com.parameters[3];
+			value1 = Game_Variables[ins.params[1]];
+			if (ins.params[2] == 0) {
+				value2 = ins.params[3];
 			} else {
-				value2 = Game_Variables[com.parameters[3]];
+				value2 = Game_Variables[ins.params[3]];
 			}
-			switch (com.parameters[4]) {
+			switch (ins.params[4]) {
 				case 0:
 					// Equal to
 					result = (value1 == value2);
@@ -1859,8 +1876,8 @@ bool Game_Interpreter_Map::CommandConditionalBranch(RPG::EventCommand const& com
 			break;
 		case 2:
 			value1 = Main_Data::game_party->GetTimer(Main_Data::game_party->Timer1);
-			value2 = com.parameters[1] * DEFAULT_FPS;
-			switch (com.parameters[2]) {
+			value2 = ins.params[1] * DEFAULT_FPS;
+			switch (ins.params[2]) {
 				case 0:
 					result = (value1 >= value2);
 					break;
@@ -1871,64 +1888,64 @@ bool Game_Interpreter_Map::CommandConditionalBranch(RPG::EventCommand const& com
 			break;
 		case 3:
 			// Gold
-			if (com.parameters[2] == 0) {
+			if (ins.params[2] == 0) {
 				// Greater than or equal
-				result = (Main_Data::game_party->GetGold() >= com.parameters[1]);
+				result = (Main_Data::game_party->GetGold() >= ins.params[1]);
 			} else {
 				// Less than or equal
-				result = (Main_Data::game_party->GetGold() <= com.parameters[1]);
+				result = (Main_Data::game_party->GetGold() <= ins.params[1]);
 			}
 			break;
 		case 4:
 			// Item
-			if (com.parameters[2] == 0) {
+			if (ins.params[2] == 0) {
 				// Having
-				result = Main_Data::game_party->GetItemCount(com.parameters[1])
-					+ Main_Data::game_party->GetItemCount(com.parameters[1], true) > 0;
+				result = Main_Data::game_party->GetItemCount(ins.params[1])
+					+ Main_Data::game_party->GetItemCount(ins.params[1], true) > 0;
 			} else {
 				// Not having
-				result = Main_Data::game_party->GetItemCount(com.parameters[1])
-					+ Main_Data::game_party->GetItemCount(com.parameters[1], true) == 0;
+				result = Main_Data::game_party->GetItemCount(ins.params[1])
+					+ Main_Data::game_party->GetItemCount(ins.params[1], true) == 0;
 			}
 			break;
 		case 5:
 			// Hero
-			actor_id = com.parameters[1];
+			actor_id = ins.params[1];
 			actor = Game_Actors::GetActor(actor_id);
-			switch (com.parameters[2]) {
+			switch (ins.params[2]) {
 				case 0:
 					// Is actor in party
 					result = Main_Data::game_party->IsActorInParty(actor_id);
 					break;
 				case 1:
 					// Name
-					result = (actor->GetName() == com.string);
+					result = (actor->GetName() == list[index].string);
 					break;
 				case 2:
 					// Higher or equal level
-					result = (actor->GetLevel() >= com.parameters[3]);
+					result = (actor->GetLevel() >= ins.params[3]);
 					break;
 				case 3:
 					// Higher or equal HP
-					result = (actor->GetHp() >= com.parameters[3]);
+					result = (actor->GetHp() >= ins.params[3]);
 					break;
 				case 4:
 					// Is skill learned
-					result = (actor->IsSkillLearned(com.parameters[3]));
+					result = (actor->IsSkillLearned(ins.params[3]));
 					break;
 				case 5:
 					// Equipped object
 					result = (
-						(actor->GetShieldId() == com.parameters[3]) ||
-						(actor->GetArmorId() == com.parameters[3]) ||
-						(actor->GetHelmetId() == com.parameters[3]) ||
-						(actor->GetAccessoryId() == com.parameters[3]) ||
-						(actor->GetWeaponId() == com.parameters[3])
+						(actor->GetShieldId() == ins.params[3]) ||
+						(actor->GetArmorId() == ins.params[3]) ||
+						(actor->GetHelmetId() == ins.params[3]) ||
+						(actor->GetAccessoryId() == ins.params[3]) ||
+						(actor->GetWeaponId() == ins.params[3])
 					);
 					break;
 				case 6:
 					// Has state
-					result = (actor->HasState(com.parameters[3]));
+					result = (actor->HasState(ins.params[3]));
 					break;
 				default:
 					;
@@ -1936,14 +1953,14 @@ bool Game_Interpreter_Map::CommandConditionalBranch(RPG::EventCommand const& com
 			break;
 		case 6:
 			// Orientation of char
-			character = GetCharacter(com.parameters[1]);
+			character = GetCharacter(ins.params[1]);
 			if (character != NULL) {
-				result = character->GetSpriteDirection() == com.parameters[2];
+				result = character->GetSpriteDirection() == ins.params[2];
 			}
 			break;
 		case 7:
 			// Vehicle in use
-			result = Game_Map::GetVehicle((Game_Vehicle::Type) (com.parameters[1]+1))->IsInUse();
+			result = Game_Map::GetVehicle((Game_Vehicle::Type) (ins.params[1]+1))->IsInUse();
 			break;
 		case 8:
 			// TODO Key decision initiated this event
@@ -1953,8 +1970,8 @@ bool Game_Interpreter_Map::CommandConditionalBranch(RPG::EventCommand const& com
 			break;
 		case 10:
 			value1 = Main_Data::game_party->GetTimer(Main_Data::game_party->Timer2);
-			value2 = com.parameters[1] * DEFAULT_FPS;
-			switch (com.parameters[2]) {
+			value2 = ins.params[1] * DEFAULT_FPS;
+			switch (ins.params[2]) {
 				case 0:
 					result = (value1 >= value2);
 					break;
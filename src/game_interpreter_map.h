@@ -58,6 +58,10 @@ public:
 	bool ExecuteCommand();
 
 private:
+	CommandFunction GetCommandFunction(int code);
+	InstructionFunction GetInstructionFunction(int code);
+	CompiledListCache& GetCompiledListCache();
+
 	bool CommandMessageOptions(RPG::EventCommand const& com);
 	bool CommandChangeExp(RPG::EventCommand const& com);
 	bool CommandChangeParameters(RPG::EventCommand const& com);
@@ -90,9 +94,9 @@ private:
 	bool CommandTradeEventLocations(RPG::EventCommand const& com);
 	bool CommandTimerOperation(RPG::EventCommand const& com);
 	bool CommandChangePBG(RPG::EventCommand const& com);
-	bool CommandJumpToLabel(RPG::EventCommand const& com);
-	bool CommandBreakLoop(RPG::EventCommand const& com);
-	bool CommandEndLoop(RPG::EventCommand const& com);
+	bool CommandJumpToLabel(Instruction const& ins);
+	bool CommandBreakLoop(Instruction const& ins);
+	bool CommandEndLoop(Instruction const& ins);
 	bool CommandOpenShop(RPG::EventCommand const& com);
 	bool CommandShowInn(RPG::EventCommand const& com);
 	bool CommandEnterHeroName(RPG::EventCommand const& com);
@@ -119,7 +123,11 @@ private:
 	bool CommandTileSubstitution(RPG::EventCommand const& com);
 	bool CommandPanScreen(RPG::EventCommand const& com);
 	bool CommandSimulatedAttack(RPG::EventCommand const& com);
-	bool CommandConditionalBranch(RPG::EventCommand const& com);
+	bool CommandConditionalBranch(Instruction const& ins);
+	bool CommandElseBranch(Instruction const& ins);
+	bool CommandTransaction(RPG::EventCommand const& com);
+	bool CommandStay(RPG::EventCommand const& com);
+	bool CommandBattleHandler(RPG::EventCommand const& com);
 	bool CommandShowBattleAnimation(RPG::EventCommand const& com);
 	bool CommandChangeClass(RPG::EventCommand const& com);
 	bool CommandHaltAllMovement(RPG::EventCommand const& com);
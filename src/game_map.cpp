@@ -21,6 +21,7 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <set>
 
 #include "async_handler.h"
 #include "system.h"
@@ -60,6 +61,56 @@ namespace {
 	tEventHash events;
 	tCommonEventHash common_events;
 
+	/**
+	 * Events of each tile, ordered by ID like the events map.
+	 * Includes inactive events, events outside of the map are in
+	 * event_tiles_outside. Empty while no map is set up.
+	 */
+	std::vector<std::vector<Game_Event*> > event_tiles;
+	std::vector<Game_Event*> event_tiles_outside;
+
+	/** Precomputed passage data of a map tile. */
+	struct TilePassage {
+		/** Passable flags of the upper layer tile. */
+		uint8_t upper;
+		/** Passable flags of the lower layer tile, walls are fully passable. */
+		uint8_t lower;
+		/** Terrain ID of the lower layer tile. */
+		int16_t terrain;
+	};
+
+	/**
+	 * Passage data of every tile. Rebuilt when the chipset changes and
+	 * patched by SubstituteDown/SubstituteUp.
+	 */
+	std::vector<TilePassage> passage_grid;
+
+	/**
+	 * Steps from every tile to the player tile over the passage grid,
+	 * -1 when the player cannot be reached. Empty when outdated.
+	 */
+	std::vector<int> player_distance;
+	int player_distance_x;
+	int player_distance_y;
+
+	/** IDs of the events depending on a switch, variable, item or actor. */
+	typedef std::map<int, std::vector<int> > tDependencyHash;
+
+	/**
+	 * Events whose page conditions reference a switch, variable, item,
+	 * actor or timer. Common events depend on their trigger switch.
+	 */
+	tDependencyHash switch_dependencies;
+	tDependencyHash variable_dependencies;
+	tDependencyHash item_dependencies;
+	tDependencyHash actor_dependencies;
+	std::vector<int> timer_dependencies;
+	tDependencyHash common_switch_dependencies;
+
+	/** Events to refresh when no full refresh is pending. */
+	std::set<int> dirty_events;
+	std::set<int> dirty_common_events;
+
 	std::auto_ptr<RPG::Map> map;
 	int scroll_direction;
 	int scroll_rest;
@@ -74,6 +125,256 @@ namespace {
 	bool pan_wait;
 	int pan_speed;
 	bool ready;
+
+	/** Number of finished map updates, see GetUpdateCount. */
+	int update_count;
+
+	/** Whether events outside of the sleep area skip their update. */
+	bool sleep_events;
+
+	/** Tiles around the screen in which events stay awake. */
+	const int sleep_margin = 4;
+
+	bool EventIdLess(const Game_Event* a, const Game_Event* b) {
+		return a->GetId() < b->GetId();
+	}
+
+	std::vector<Game_Event*>& GetEventTile(int x, int y) {
+		return Game_Map::IsValid(x, y) ? event_tiles[x + y * map->width] : event_tiles_outside;
+	}
+
+	void InsertEventTile(std::vector<Game_Event*>& tile, Game_Event* ev) {
+		tile.insert(std::upper_bound(tile.begin(), tile.end(), ev, EventIdLess), ev);
+	}
+
+	bool EraseEventTile(std::vector<Game_Event*>& tile, Game_Event* ev) {
+		std::vector<Game_Event*>::iterator it = std::find(tile.begin(), tile.end(), ev);
+		if (it == tile.end()) {
+			return false;
+		}
+		tile.erase(it);
+		return true;
+	}
+
+	void CreateEventIndex() {
+		event_tiles.clear();
+		event_tiles.resize(map->width * map->height);
+		event_tiles_outside.clear();
+
+		for (tEventHash::iterator i = events.begin(); i != events.end(); ++i) {
+			Game_Event* ev = i->second.get();
+			InsertEventTile(GetEventTile(ev->GetX(), ev->GetY()), ev);
+		}
+	}
+
+	uint8_t GetUpperPassage(int tile_index) {
+		int const tile_id = map->upper_layer[tile_index];
+		if (tile_id < BLOCK_F) {
+			// Treat like the empty upper tile
+			return passages_up[0] & ~Passable::Counter;
+		}
+		return passages_up[map_info.upper_tiles[tile_id - BLOCK_F]];
+	}
+
+	uint8_t GetLowerPassage(int tile_index) {
+		int const tile_raw_id = map->lower_layer[tile_index];
+		int tile_id;
+
+		if (tile_raw_id >= BLOCK_E) {
+			tile_id = tile_raw_id - BLOCK_E;
+			tile_id = map_info.lower_tiles[tile_id] + 18;
+
+		} else if (tile_raw_id >= BLOCK_D) {
+			tile_id = (tile_raw_id - BLOCK_D) / 50 + 6;
+			int autotile_id = (tile_raw_id - BLOCK_D) % 50;
+
+			if (((passages_down[tile_id] & Passable::Wall) != 0) && (
+					(autotile_id >= 20 && autotile_id <= 23) ||
+					(autotile_id >= 33 && autotile_id <= 37) ||
+					autotile_id == 42 || autotile_id == 43 ||
+					autotile_id == 45 || autotile_id == 46))
+				return Passable::Down | Passable::Left | Passable::Right | Passable::Up;
+
+		} else if (tile_raw_id >= BLOCK_C) {
+			tile_id = (tile_raw_id - BLOCK_C) / 50 + 3;
+
+		} else {
+			tile_id = tile_raw_id / 1000;
+		}
+
+		return passages_down[tile_id];
+	}
+
+	int GetTerrain(int tile_index) {
+		unsigned const chipID = map->lower_layer[tile_index];
+		unsigned const chip_index =
+			(chipID <  3050)?  0 + chipID/1000 :
+			(chipID <  4000)?  4 + (chipID-3050)/50 :
+			(chipID <  5000)?  6 + (chipID-4000)/50 :
+			(chipID <  5144)? 18 + (chipID-5000) :
+			0;
+		unsigned const chipset_index = map_info.chipset_id - 1;
+
+		assert(chipset_index < Data::data.chipsets.size());
+		assert(chip_index < Data::data.chipsets[chipset_index].terrain_data.size());
+
+		return Data::data.chipsets[chipset_index].terrain_data[chip_index];
+	}
+
+	void CreatePassageGrid() {
+		size_t const size = map->width * map->height;
+		passage_grid.resize(size);
+
+		for (size_t i = 0; i < size; ++i) {
+			passage_grid[i].upper = GetUpperPassage(i);
+			passage_grid[i].lower = GetLowerPassage(i);
+			passage_grid[i].terrain = GetTerrain(i);
+		}
+
+		player_distance.clear();
+	}
+
+	/** Breadth first search from the player tile against the walking direction. */
+	void CreatePlayerDistance(int player_x, int player_y) {
+		static const int dx[] = { 0, 1, 0, -1 };
+		static const int dy[] = { -1, 0, 1, 0 };
+		static const int bits[] = { Passable::Up, Passable::Right, Passable::Down, Passable::Left };
+
+		int const width = map->width;
+		player_distance.assign(width * map->height, -1);
+		player_distance_x = player_x;
+		player_distance_y = player_y;
+
+		if (!Game_Map::IsValid(player_x, player_y)) {
+			return;
+		}
+
+		std::vector<int> queue;
+		queue.push_back(player_x + player_y * width);
+		player_distance[queue.back()] = 0;
+
+		for (size_t head = 0; head < queue.size(); ++head) {
+			int const to = queue[head];
+			int const x = to % width;
+			int const y = to / width;
+
+			// Tiles reaching the current one with a step in direction d
+			for (int d = 0; d < 4; ++d) {
+				int const from_x = Game_Map::RoundX(x - dx[d]);
+				int const from_y = Game_Map::RoundY(y - dy[d]);
+				if (!Game_Map::IsValid(from_x, from_y)) {
+					continue;
+				}
+
+				int const from = from_x + from_y * width;
+				if (player_distance[from] != -1 ||
+					!Game_Map::IsPassableTile(bits[d], from) ||
+					!Game_Map::IsPassableTile(bits[(d + 2) % 4], to)) {
+					continue;
+				}
+
+				player_distance[from] = player_distance[to] + 1;
+				queue.push_back(from);
+			}
+		}
+	}
+
+	void AddDependency(tDependencyHash& dependencies, int id, int event_id) {
+		std::vector<int>& list = dependencies[id];
+		if (list.empty() || list.back() != event_id) {
+			list.push_back(event_id);
+		}
+	}
+
+	void CreateRefreshDependencies() {
+		switch_dependencies.clear();
+		variable_dependencies.clear();
+		item_dependencies.clear();
+		actor_dependencies.clear();
+		timer_dependencies.clear();
+		common_switch_dependencies.clear();
+		dirty_events.clear();
+		dirty_common_events.clear();
+
+		for (size_t i = 0; i < map->events.size(); ++i) {
+			RPG::Event const& event = map->events[i];
+			bool timer = false;
+
+			std::vector<RPG::EventPage>::const_iterator it;
+			for (it = event.pages.begin(); it != event.pages.end(); ++it) {
+				RPG::EventPageCondition const& condition = it->condition;
+				if (condition.flags.switch_a)
+					AddDependency(switch_dependencies, condition.switch_a_id, event.ID);
+				if (condition.flags.switch_b)
+					AddDependency(switch_dependencies, condition.switch_b_id, event.ID);
+				if (condition.flags.variable)
+					AddDependency(variable_dependencies, condition.variable_id, event.ID);
+				if (condition.flags.item)
+					AddDependency(item_dependencies, condition.item_id, event.ID);
+				if (condition.flags.actor)
+					AddDependency(actor_dependencies, condition.actor_id, event.ID);
+				timer = timer || condition.flags.timer || condition.flags.timer2;
+			}
+
+			if (timer) {
+				timer_dependencies.push_back(event.ID);
+			}
+		}
+
+		for (tCommonEventHash::iterator i = common_events.begin(); i != common_events.end(); ++i) {
+			if (i->second->GetSwitchFlag()) {
+				AddDependency(common_switch_dependencies, i->second->GetSwitchId(), i->first);
+			}
+		}
+	}
+
+	void MarkDependencies(tDependencyHash const& dependencies, int id) {
+		if (need_refresh) {
+			return;
+		}
+
+		tDependencyHash::const_iterator it = dependencies.find(id);
+		if (it != dependencies.end()) {
+			dirty_events.insert(it->second.begin(), it->second.end());
+		}
+	}
+
+	/** Checks an axis of the sleep area, view is the first visible tile. */
+	bool IsNearView(int pos, int view, int view_size, int map_size, bool loop) {
+		int distance = pos - view + sleep_margin;
+		if (loop) {
+			distance = (distance % map_size + map_size) % map_size;
+		}
+		return distance >= 0 && distance < view_size + 2 * sleep_margin;
+	}
+
+	/** Checks whether a tile is on the screen or within sleep_margin of it. */
+	bool IsInSleepArea(int x, int y) {
+		return IsNearView(x, map_info.position_x / SCREEN_TILE_WIDTH, 20, Game_Map::GetWidth(), Game_Map::LoopHorizontal()) &&
+			IsNearView(y, map_info.position_y / SCREEN_TILE_WIDTH, 15, Game_Map::GetHeight(), Game_Map::LoopVertical());
+	}
+
+#ifdef _DEBUG
+	/** Cross-checks a tile of the index against a linear search. */
+	void ValidateEventTile(int x, int y) {
+		std::vector<Game_Event*> linear;
+		for (tEventHash::iterator i = events.begin(); i != events.end(); ++i) {
+			if (i->second->IsInPosition(x, y)) {
+				linear.push_back(i->second.get());
+			}
+		}
+
+		std::vector<Game_Event*> indexed;
+		std::vector<Game_Event*> const& tile = GetEventTile(x, y);
+		for (std::vector<Game_Event*>::const_iterator i = tile.begin(); i != tile.end(); ++i) {
+			if ((*i)->IsInPosition(x, y)) {
+				indexed.push_back(*i);
+			}
+		}
+
+		assert(linear == indexed && "Event tile index out of sync");
+	}
+#endif
 }
 
 void Game_Map::Init() {
@@ -106,12 +407,21 @@ void Game_Map::Init() {
 	location.pan_current_x = 0;
 	location.pan_current_y = 0;
 	ready = false;
+
+	sleep_events = Player::sleep_events_flag;
 }
 
 void Game_Map::Dispose() {
+	event_tiles.clear();
+	event_tiles_outside.clear();
+	passage_grid.clear();
+	player_distance.clear();
 	events.clear();
 	pending.clear();
 
+	// Tables are keyed by command lists, including those of the events
+	Game_Interpreter::ClearTableCaches();
+
 	if (Main_Data::game_screen) {
 		Main_Data::game_screen->Reset();
 	}
@@ -132,6 +442,8 @@ void Game_Map::Setup(int _id) {
 	for (size_t i = 0; i < map->events.size(); ++i) {
 		events.insert(std::make_pair(map->events[i].ID, EASYRPG_MAKE_SHARED<Game_Event>(location.map_id, map->events[i])));
 	}
+	CreateEventIndex();
+	CreateRefreshDependencies();
 
 	location.pan_finish_x = 0;
 	location.pan_finish_y = 0;
@@ -160,6 +472,7 @@ void Game_Map::SetupFromSave() {
 		if (evnt->IsMoveRouteOverwritten())
 			pending.push_back(evnt.get());
 	}
+	CreateEventIndex();
 
 	for (size_t i = 0; i < Data::commonevents.size(); ++i) {
 		EASYRPG_SHARED_PTR<Game_CommonEvent> evnt;
@@ -172,12 +485,14 @@ void Game_Map::SetupFromSave() {
 
 		common_events.insert(std::make_pair(Data::commonevents[i].ID, evnt));
 	}
+	CreateRefreshDependencies();
 
 	for (size_t i = 0; i < 3; i++)
 		if (vehicles[i]->IsMoveRouteOverwritten())
 			pending.push_back(vehicles[i]);
 
 	map_info.Fixup(*map.get());
+	CreatePassageGrid();
 
 	// FIXME: Handle Pan correctly
 	location.pan_current_x = 0;
@@ -303,18 +618,72 @@ void Game_Map::PlayBgm() {
 
 void Game_Map::Refresh() {
 	if (location.map_id > 0) {
-		for (tEventHash::iterator i = events.begin(); i != events.end(); ++i) {
-			i->second->Refresh();
-		}
+		if (need_refresh) {
+			for (tEventHash::iterator i = events.begin(); i != events.end(); ++i) {
+				i->second->Refresh();
+			}
 
-		for (tCommonEventHash::iterator i = common_events.begin(); i != common_events.end(); ++i) {
-			i->second->Refresh();
+			for (tCommonEventHash::iterator i = common_events.begin(); i != common_events.end(); ++i) {
+				i->second->Refresh();
+			}
+
+			dirty_events.clear();
+			dirty_common_events.clear();
+		} else {
+			// Refreshing can change switches and mark more events
+			std::set<int> refresh_events;
+			std::set<int> refresh_common_events;
+			refresh_events.swap(dirty_events);
+			refresh_common_events.swap(dirty_common_events);
+
+			for (std::set<int>::iterator i = refresh_events.begin(); i != refresh_events.end(); ++i) {
+				tEventHash::iterator it = events.find(*i);
+				if (it != events.end()) {
+					it->second->Refresh();
+				}
+			}
+
+			for (std::set<int>::iterator i = refresh_common_events.begin(); i != refresh_common_events.end(); ++i) {
+				tCommonEventHash::iterator it = common_events.find(*i);
+				if (it != common_events.end()) {
+					it->second->Refresh();
+				}
+			}
 		}
 	}
 
 	need_refresh = false;
 }
 
+void Game_Map::SetNeedRefreshForSwitch(int switch_id) {
+	MarkDependencies(switch_dependencies, switch_id);
+
+	if (!need_refresh) {
+		tDependencyHash::const_iterator it = common_switch_dependencies.find(switch_id);
+		if (it != common_switch_dependencies.end()) {
+			dirty_common_events.insert(it->second.begin(), it->second.end());
+		}
+	}
+}
+
+void Game_Map::SetNeedRefreshForVariable(int variable_id) {
+	MarkDependencies(variable_dependencies, variable_id);
+}
+
+void Game_Map::SetNeedRefreshForItem(int item_id) {
+	MarkDependencies(item_dependencies, item_id);
+}
+
+void Game_Map::SetNeedRefreshForActor(int actor_id) {
+	MarkDependencies(actor_dependencies, actor_id);
+}
+
+void Game_Map::SetNeedRefreshForTimer() {
+	if (!need_refresh) {
+		dirty_events.insert(timer_dependencies.begin(), timer_dependencies.end());
+	}
+}
+
 Game_Interpreter& Game_Map::GetInterpreter() {
 	assert(interpreter);
 	return *interpreter;
@@ -493,12 +862,7 @@ bool Game_Map::IsPassableVehicle(int x, int y, Game_Vehicle::Type vehicle_type)
 		}
 	}
 
-	int const tile_index = x + y * GetWidth();
-
-	tile_id = map->upper_layer[tile_index] - BLOCK_F;
-	tile_id = map_info.upper_tiles[tile_id];
-
-	if ((passages_up[tile_id] & Passable::Above) == 0)
+	if ((passage_grid[x + y * GetWidth()].upper & Passable::Above) == 0)
 		return false;
 
 	for (int i = 0; i < 3; i++) {
@@ -519,15 +883,19 @@ bool Game_Map::IsLandable(int x, int y, const Game_Character *self_event) {
 	int bit = Passable::Down | Passable::Right | Passable::Left | Passable::Up;
 
 	if (self_event) {
-		for (tEventHash::iterator i = events.begin(); i != events.end(); ++i) {
-			Game_Event* evnt = i->second.get();
+#ifdef _DEBUG
+		ValidateEventTile(x, y);
+#endif
+		std::vector<Game_Event*> const& tile = GetEventTile(x, y);
+		for (std::vector<Game_Event*>::const_iterator i = tile.begin(); i != tile.end(); ++i) {
+			Game_Event* evnt = *i;
 			if (evnt != self_event && evnt->IsInPosition(x, y)) {
 				if (!evnt->GetThrough()) {
 					if (evnt->GetLayer() == RPG::EventPage::Layers_same) {
 						return false;
 					} else if (evnt->GetTileId() >= 0 && evnt->GetLayer() == RPG::EventPage::Layers_below) {
 						// Event layer Chipset Tile
-						tile_id = i->second->GetTileId();
+						tile_id = evnt->GetTileId();
 						return (passages_up[tile_id] & bit != 0);
 					}
 				}
@@ -538,41 +906,30 @@ bool Game_Map::IsLandable(int x, int y, const Game_Character *self_event) {
 	return IsPassableTile(bit, x + y * GetWidth());
 }
 
-bool Game_Map::IsPassableTile(int bit, int tile_index) {
-	int tile_id = map->upper_layer[tile_index] - BLOCK_F;
-	tile_id = map_info.upper_tiles[tile_id];
-
-	if ((passages_up[tile_id] & bit) == 0)
-		return false;
-
-	if ((passages_up[tile_id] & Passable::Above) == 0)
-		return true;
-
-	int tile_raw_id = map->lower_layer[tile_index];
+int Game_Map::GetPlayerDistance(int x, int y) {
+	if (!IsValid(x, y)) {
+		return -1;
+	}
 
-	if (tile_raw_id >= BLOCK_E) {
-		tile_id = tile_raw_id - BLOCK_E;
-		tile_id = map_info.lower_tiles[tile_id] + 18;
+	int const player_x = Main_Data::game_player->GetX();
+	int const player_y = Main_Data::game_player->GetY();
+	if (player_distance.empty() || player_x != player_distance_x || player_y != player_distance_y) {
+		CreatePlayerDistance(player_x, player_y);
+	}
 
-	} else if (tile_raw_id >= BLOCK_D) {
-		tile_id = (tile_raw_id - BLOCK_D) / 50 + 6;
-		int autotile_id = (tile_raw_id - BLOCK_D) % 50;
+	return player_distance[x + y * GetWidth()];
+}
 
-		if (((passages_down[tile_id] & Passable::Wall) != 0) && (
-				(autotile_id >= 20 && autotile_id <= 23) ||
-				(autotile_id >= 33 && autotile_id <= 37) ||
-				autotile_id == 42 || autotile_id == 43 ||
-				autotile_id == 45 || autotile_id == 46))
-			return true;
+bool Game_Map::IsPassableTile(int bit, int tile_index) {
+	TilePassage const& passage = passage_grid[tile_index];
 
-	} else if (tile_raw_id >= BLOCK_C) {
-		tile_id = (tile_raw_id - BLOCK_C) / 50 + 3;
+	if ((passage.upper & bit) == 0)
+		return false;
 
-	} else if (map->lower_layer[tile_index] < BLOCK_C) {
-		tile_id = tile_raw_id / 1000;
-	}
+	if ((passage.upper & Passable::Above) == 0)
+		return true;
 
-	return (passages_down[tile_id] & bit) != 0;
+	return (passage.lower & bit) != 0;
 }
 
 int Game_Map::GetBushDepth(int x, int y) {
@@ -584,28 +941,13 @@ int Game_Map::GetBushDepth(int x, int y) {
 bool Game_Map::IsCounter(int x, int y) {
 	if (!Game_Map::IsValid(x, y)) return false;
 
-	int const tile_id = map->upper_layer[x + y * GetWidth()];
-	if (tile_id < BLOCK_F) return false;
-	int const index = map_info.upper_tiles[tile_id - BLOCK_F];
-	return !!(passages_up[index] & Passable::Counter);
+	return !!(passage_grid[x + y * GetWidth()].upper & Passable::Counter);
 }
 
 int Game_Map::GetTerrainTag(int const x, int const y) {
 	if (!Game_Map::IsValid(x, y)) return 1;
 
-	unsigned const chipID = map->lower_layer[x + y * GetWidth()];
-	unsigned const chip_index =
-		(chipID <  3050)?  0 + chipID/1000 :
-		(chipID <  4000)?  4 + (chipID-3050)/50 :
-		(chipID <  5000)?  6 + (chipID-4000)/50 :
-		(chipID <  5144)? 18 + (chipID-5000) :
-		0;
-	unsigned const chipset_index = map_info.chipset_id - 1;
-
-	assert(chipset_index < Data::data.chipsets.size());
-	assert(chip_index < Data::data.chipsets[chipset_index].terrain_data.size());
-
-	return Data::data.chipsets[chipset_index].terrain_data[chip_index];
+	return passage_grid[x + y * GetWidth()].terrain;
 }
 
 bool Game_Map::AirshipLandOk(int const x, int const y) {
@@ -615,16 +957,37 @@ bool Game_Map::AirshipLandOk(int const x, int const y) {
 void Game_Map::GetEventsXY(std::vector<Game_Event*>& events, int x, int y) {
 	std::vector<Game_Event*> result;
 
-	tEventHash::const_iterator i;
-	for (i = Game_Map::GetEvents().begin(); i != Game_Map::GetEvents().end(); ++i) {
-		if (i->second->IsInPosition(x, y) && i->second->GetActive()) {
-			result.push_back(i->second.get());
+#ifdef _DEBUG
+	ValidateEventTile(x, y);
+#endif
+
+	std::vector<Game_Event*> const& tile = GetEventTile(x, y);
+	for (std::vector<Game_Event*>::const_iterator i = tile.begin(); i != tile.end(); ++i) {
+		if ((*i)->IsInPosition(x, y) && (*i)->GetActive()) {
+			result.push_back(*i);
 		}
 	}
 
 	events.swap(result);
 }
 
+void Game_Map::UpdateEventPosition(Game_Event* ev, int old_x, int old_y) {
+	if (event_tiles.empty()) {
+		return;
+	}
+
+	std::vector<Game_Event*>& old_tile = GetEventTile(old_x, old_y);
+	std::vector<Game_Event*>& new_tile = GetEventTile(ev->GetX(), ev->GetY());
+	if (&old_tile == &new_tile) {
+		return;
+	}
+
+	// Only events of the current map are in the index
+	if (EraseEventTile(old_tile, ev)) {
+		InsertEventTile(new_tile, ev);
+	}
+}
+
 bool Game_Map::LoopHorizontal() {
 	return map->scroll_type == RPG::Map::ScrollType_horizontal || map->scroll_type == RPG::Map::ScrollType_both;
 }
@@ -658,10 +1021,14 @@ int Game_Map::YwithDirection(int y, int direction) {
 }
 
 int Game_Map::CheckEvent(int x, int y) {
-	tEventHash::iterator i;
-	for (i = events.begin(); i != events.end(); ++i) {
-		if (i->second->IsInPosition(x, y)) {
-			return i->second->GetId();
+#ifdef _DEBUG
+	ValidateEventTile(x, y);
+#endif
+
+	std::vector<Game_Event*> const& tile = GetEventTile(x, y);
+	for (std::vector<Game_Event*>::const_iterator i = tile.begin(); i != tile.end(); ++i) {
+		if ((*i)->IsInPosition(x, y)) {
+			return (*i)->GetId();
 		}
 	}
 
@@ -707,7 +1074,12 @@ void Game_Map::Update() {
 
 	for (tEventHash::iterator i = events.begin();
 		i != events.end(); ++i) {
-		i->second->Update();
+		Game_Event* ev = i->second.get();
+		if (sleep_events && ev->CanSleep() && !IsInSleepArea(ev->GetX(), ev->GetY())) {
+			ev->Sleep();
+		} else {
+			ev->Update();
+		}
 	}
 
 	for (tCommonEventHash::iterator i = common_events.begin();
@@ -719,6 +1091,8 @@ void Game_Map::Update() {
 		vehicles[i]->Update();
 
 	free_interpreters.clear();
+
+	++update_count;
 }
 
 RPG::Map const& Game_Map::GetMap() {
@@ -726,6 +1100,10 @@ RPG::Map const& Game_Map::GetMap() {
 }
 
 
+int Game_Map::GetUpdateCount() {
+	return update_count;
+}
+
 int Game_Map::GetMapId() {
 	return location.map_id;
 }
@@ -882,7 +1260,7 @@ void Game_Map::SetDisplayY(int new_display_y) {
 }
 
 bool Game_Map::GetNeedRefresh() {
-	return need_refresh;
+	return need_refresh || !dirty_events.empty() || !dirty_common_events.empty();
 }
 void Game_Map::SetNeedRefresh(bool new_need_refresh) {
 	need_refresh = new_need_refresh;
@@ -984,6 +1362,9 @@ void Game_Map::SetChipset(int id) {
 		map_info.lower_tiles[i] = i;
 		map_info.upper_tiles[i] = i;
 	}
+	if (map.get()) {
+		CreatePassageGrid();
+	}
 }
 
 Game_Vehicle* Game_Map::GetVehicle(Game_Vehicle::Type which) {
@@ -1016,19 +1397,44 @@ void Game_Map::RemoveAllPendingMoves() {
 }
 
 void Game_Map::SubstituteDown(int old_id, int new_id) {
+	bool changed = false;
 	for (size_t i = 0; i < map_info.lower_tiles.size(); ++i) {
 		if (map_info.lower_tiles[i] == old_id) {
 			map_info.lower_tiles[i] = (uint8_t) new_id;
+			changed = true;
+		}
+	}
+
+	if (!changed) {
+		return;
+	}
+
+	// Only the tiles of block E can be substituted
+	for (size_t i = 0; i < passage_grid.size(); ++i) {
+		if (map->lower_layer[i] >= BLOCK_E) {
+			passage_grid[i].lower = GetLowerPassage(i);
 		}
 	}
+	player_distance.clear();
 }
 
 void Game_Map::SubstituteUp(int old_id, int new_id) {
+	bool changed = false;
 	for (size_t i = 0; i < map_info.upper_tiles.size(); ++i) {
 		if (map_info.upper_tiles[i] == old_id) {
 			map_info.upper_tiles[i] = (uint8_t) new_id;
+			changed = true;
 		}
 	}
+
+	if (!changed) {
+		return;
+	}
+
+	for (size_t i = 0; i < passage_grid.size(); ++i) {
+		passage_grid[i].upper = GetUpperPassage(i);
+	}
+	player_distance.clear();
 }
 
 void Game_Map::LockPan() {
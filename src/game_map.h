@@ -87,6 +87,8 @@ namespace Game_Map {
 
 	/**
 	 * Refreshes the map.
+	 * Refreshes all events after SetNeedRefresh(true), otherwise only the
+	 * events marked by the SetNeedRefreshFor functions.
 	 */
 	void Refresh();
 
@@ -139,6 +141,18 @@ namespace Game_Map {
 	 */
 	bool IsPassable(int x, int y, int d, const Game_Character* self_event = NULL);
 
+	/**
+	 * Gets the number of steps from a tile to the player.
+	 * Only the passability of the tiles is considered, events are ignored.
+	 * The distances of all tiles are calculated once after the player
+	 * moved and shared by all characters.
+	 *
+	 * @param x tile x.
+	 * @param y tile y.
+	 * @return steps to the player, -1 when the player is unreachable.
+	 */
+	int GetPlayerDistance(int x, int y);
+
 	/**
 	 * Gets if a tile coordinate is passable in a direction by a vehicle.
 	 *
@@ -244,6 +258,14 @@ namespace Game_Map {
 	 */
 	int GetMapId();
 
+	/**
+	 * Gets the number of map updates since the player started.
+	 * Waiting interpreters use it as their clock.
+	 *
+	 * @return map update count.
+	 */
+	int GetUpdateCount();
+
 	/**
 	 * Gets current map width.
 	 *
@@ -386,7 +408,7 @@ namespace Game_Map {
 	/**
 	 * Gets need refresh flag.
 	 *
-	 * @return need refresh flag.
+	 * @return whether a full refresh or a refresh of some events is pending.
 	 */
 	bool GetNeedRefresh();
 
@@ -418,6 +440,43 @@ namespace Game_Map {
 	 */
 	void SetNeedRefresh(bool need_refresh);
 
+	/**
+	 * Marks the events whose page conditions reference a switch for the
+	 * next refresh, including common events triggered by the switch.
+	 *
+	 * @param switch_id switch ID.
+	 */
+	void SetNeedRefreshForSwitch(int switch_id);
+
+	/**
+	 * Marks the events whose page conditions reference a variable for
+	 * the next refresh.
+	 *
+	 * @param variable_id variable ID.
+	 */
+	void SetNeedRefreshForVariable(int variable_id);
+
+	/**
+	 * Marks the events whose page conditions reference an item for the
+	 * next refresh.
+	 *
+	 * @param item_id item ID.
+	 */
+	void SetNeedRefreshForItem(int item_id);
+
+	/**
+	 * Marks the events whose page conditions reference an actor for the
+	 * next refresh.
+	 *
+	 * @param actor_id actor ID.
+	 */
+	void SetNeedRefreshForActor(int actor_id);
+
+	/**
+	 * Marks the events with timer page conditions for the next refresh.
+	 */
+	void SetNeedRefreshForTimer();
+
 	/**
 	 * Gets lower passages list.
 	 *
@@ -467,8 +526,27 @@ namespace Game_Map {
 	 */
 	tCommonEventHash& GetCommonEvents();
 
+	/**
+	 * Gets the active events at a tile.
+	 * Looks up the tile index and only visits the events on that tile.
+	 *
+	 * @param events receives the events, ordered by ID.
+	 * @param x tile x.
+	 * @param y tile y.
+	 */
 	void GetEventsXY(std::vector<Game_Event*>& events, int x, int y);
 
+	/**
+	 * Moves an event to its new tile in the tile index.
+	 * Called by Game_Event whenever its position changes, does nothing for
+	 * events that are not on the current map yet.
+	 *
+	 * @param ev event that moved.
+	 * @param old_x previous tile x.
+	 * @param old_y previous tile y.
+	 */
+	void UpdateEventPosition(Game_Event* ev, int old_x, int old_y);
+
 	bool LoopHorizontal();
 	bool LoopVertical();
 
@@ -124,6 +124,8 @@ void Game_Party::AddItem(int item_id, int amount) {
 		return;
 	}
 
+	Game_Map::SetNeedRefreshForItem(item_id);
+
 	for (int i = 0; i < (int) data.item_ids.size(); i++) {
 		if (data.item_ids[i] != item_id)
 			continue;
@@ -170,6 +172,8 @@ void Game_Party::ConsumeItemUse(int item_id) {
 		return;
 	}
 
+	Game_Map::SetNeedRefreshForItem(item_id);
+
 	for (int i = 0; i < (int) data.item_ids.size(); i++) {
 		if (data.item_ids[i] != item_id)
 			continue;
@@ -277,6 +281,7 @@ void Game_Party::AddActor(int actor_id) {
 		return;
 	data.party.push_back((int16_t)actor_id);
 	Main_Data::game_player->Refresh();
+	Game_Map::SetNeedRefreshForActor(actor_id);
 }
 
 void Game_Party::RemoveActor(int actor_id) {
@@ -284,6 +289,7 @@ void Game_Party::RemoveActor(int actor_id) {
 		return;
 	data.party.erase(std::find(data.party.begin(), data.party.end(), actor_id));
 	Main_Data::game_player->Refresh();
+	Game_Map::SetNeedRefreshForActor(actor_id);
 }
 
 void Game_Party::Clear() {
@@ -344,11 +350,11 @@ void Game_Party::SetTimer(int which, int seconds) {
 	switch (which) {
 		case Timer1:
 			data.timer1_secs = seconds * DEFAULT_FPS;
-			Game_Map::SetNeedRefresh(true);
+			Game_Map::SetNeedRefreshForTimer();
 			break;
 		case Timer2:
 			data.timer2_secs = seconds * DEFAULT_FPS;
-			Game_Map::SetNeedRefresh(true);
+			Game_Map::SetNeedRefreshForTimer();
 			break;
 	}
 }
@@ -386,7 +392,7 @@ void Game_Party::UpdateTimers() {
 	if (data.timer1_active && (data.timer1_battle || !battle) && data.timer1_secs > 0) {
 		data.timer1_secs--;
 		if (data.timer1_secs % DEFAULT_FPS == 0) {
-			Game_Map::SetNeedRefresh(true);
+			Game_Map::SetNeedRefreshForTimer();
 		}
 		if (data.timer1_secs == 0) {
 			StopTimer(Timer1);
@@ -395,7 +401,7 @@ void Game_Party::UpdateTimers() {
 	if (data.timer2_active && (data.timer2_battle || !battle) && data.timer2_secs > 0) {
 		data.timer2_secs--;
 		if (data.timer2_secs % DEFAULT_FPS == 0) {
-			Game_Map::SetNeedRefresh(true);
+			Game_Map::SetNeedRefreshForTimer();
 		}
 		if (data.timer2_secs == 0) {
 			StopTimer(Timer2);
@@ -0,0 +1,36 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "game_switches.h"
+#include "game_map.h"
+#include "player.h"
+
+void Game_Switches_Class::Set(int switch_id, bool value) {
+	if (!Resize(switch_id)) {
+		return;
+	}
+
+	bool const old_value = switches[switch_id - 1];
+	if (old_value == value) {
+		return;
+	}
+
+	switches[switch_id - 1] = value;
+	changes.Record(switch_id, old_value, value, Player::GetFrames());
+	Game_Map::SetNeedRefreshForSwitch(switch_id);
+}
@@ -20,6 +20,7 @@
 
 // Headers
 #include <vector>
+#include "change_journal.h"
 #include "main_data.h"
 #include "output.h"
 
@@ -30,25 +31,72 @@
  */
 class Game_Switches_Class {
 public:
+	/**
+	 * Reference to a switch, assignments go through Set.
+	 */
+	class Reference {
+	public:
+		Reference(Game_Switches_Class& owner, int switch_id) :
+			owner(owner), switch_id(switch_id) {}
+
+		operator bool() const {
+			return owner.Get(switch_id);
+		}
+
+		Reference& operator=(bool value) {
+			owner.Set(switch_id, value);
+			return *this;
+		}
+
+		Reference& operator=(const Reference& other) {
+			return *this = (bool)other;
+		}
+
+	private:
+		Game_Switches_Class& owner;
+		int switch_id;
+	};
+
 	Game_Switches_Class(std::vector<bool>& switches) :
 		switches(switches) {}
 
-	std::vector<bool>::reference operator[](int switch_id) {
-		if (!isValidSwitch(switch_id)) {
-			if (switch_id > 0 && switch_id <= PLAYER_VAR_LIMIT) {
-				Output::Debug("Resizing switch array to %d elements.", switch_id);
-				switches.resize(switch_id);
-			}
-			else {
-				Output::Debug("Switch index %d is invalid.", switch_id);
-				dummy.resize(1);
-				return dummy[0];
-			}
+	Reference operator[](int switch_id) {
+		return Reference(*this, switch_id);
+	}
+
+	/**
+	 * Gets a switch. Invalid switches are off.
+	 *
+	 * @param switch_id switch ID.
+	 * @return switch value.
+	 */
+	bool Get(int switch_id) {
+		if (!Resize(switch_id)) {
+			return false;
 		}
 
 		return switches[switch_id - 1];
 	}
-	
+
+	/**
+	 * Sets a switch. When the value changes the change is recorded and the
+	 * map events depending on the switch are marked for refresh.
+	 *
+	 * @param switch_id switch ID.
+	 * @param value new value.
+	 */
+	void Set(int switch_id, bool value);
+
+	/**
+	 * Gets the recorded switch changes.
+	 * The changed IDs are cleared at the start of every frame.
+	 *
+	 * @return change journal.
+	 */
+	ChangeJournal<bool>& GetChanges() {
+		return changes;
+	}
+
 	std::string GetName(int _id) {
 		if (!(_id > 0 && _id <= (int)Data::switches.size())) {
 			return "";
@@ -70,11 +118,27 @@ public:
 		switches.resize(Data::switches.size());
 
 		std::fill(switches.begin(), switches.end(), false);
+		changes.Clear();
 	}
 
 private:
+	bool Resize(int switch_id) {
+		if (!isValidSwitch(switch_id)) {
+			if (switch_id > 0 && switch_id <= PLAYER_VAR_LIMIT) {
+				Output::Debug("Resizing switch array to %d elements.", switch_id);
+				switches.resize(switch_id);
+			}
+			else {
+				Output::Debug("Switch index %d is invalid.", switch_id);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	std::vector<bool>& switches;
-	std::vector<bool> dummy;
+	ChangeJournal<bool> changes;
 };
 
 #undef PLAYER_VAR_LIMIT
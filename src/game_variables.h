@@ -19,6 +19,7 @@
 #define _GAME_VARIABLES_H_
 
 // Headers
+#include "change_journal.h"
 #include "data.h"
 #include "output.h"
 #include <vector>
@@ -30,24 +31,90 @@
  */
 class Game_Variables_Class {
 public:
+	/**
+	 * Reference to a variable, assignments go through Set.
+	 */
+	class Reference {
+	public:
+		Reference(Game_Variables_Class& owner, int variable_id) :
+			owner(owner), variable_id(variable_id) {}
+
+		operator int() const {
+			return owner.Get(variable_id);
+		}
+
+		Reference& operator=(int value) {
+			owner.Set(variable_id, value);
+			return *this;
+		}
+
+		Reference& operator=(const Reference& other) {
+			return *this = (int)other;
+		}
+
+		Reference& operator+=(int value) {
+			return *this = owner.Get(variable_id) + value;
+		}
+
+		Reference& operator-=(int value) {
+			return *this = owner.Get(variable_id) - value;
+		}
+
+		Reference& operator*=(int value) {
+			return *this = owner.Get(variable_id) * value;
+		}
+
+		Reference& operator/=(int value) {
+			return *this = owner.Get(variable_id) / value;
+		}
+
+		Reference& operator%=(int value) {
+			return *this = owner.Get(variable_id) % value;
+		}
+
+	private:
+		Game_Variables_Class& owner;
+		int variable_id;
+	};
+
 	Game_Variables_Class(std::vector<uint32_t>& variables) :
 		variables(variables) {}
 
-	int& operator[] (int variable_id) {
-		if (!isValidVar(variable_id)) {
-			if (variable_id > 0 && variable_id <= PLAYER_VAR_LIMIT) {
-				Output::Debug("Resizing variable array to %d elements.", variable_id);
-				variables.resize(variable_id);
-			}
-			else {
-				Output::Debug("Variable index %d is invalid.",
-					variable_id);
-				dummy = 0;
-				return dummy;
-			}
+	Reference operator[](int variable_id) {
+		return Reference(*this, variable_id);
+	}
+
+	/**
+	 * Gets a variable. Invalid variables are 0.
+	 *
+	 * @param variable_id variable ID.
+	 * @return variable value.
+	 */
+	int Get(int variable_id) {
+		if (!Resize(variable_id)) {
+			return 0;
 		}
 
-		return (int&) variables[variable_id - 1];
+		return (int) variables[variable_id - 1];
+	}
+
+	/**
+	 * Sets a variable. When the value changes the change is recorded and
+	 * the map events depending on the variable are marked for refresh.
+	 *
+	 * @param variable_id variable ID.
+	 * @param value new value.
+	 */
+	void Set(int variable_id, int value);
+
+	/**
+	 * Gets the recorded variable changes.
+	 * The changed IDs are cleared at the start of every frame.
+	 *
+	 * @return change journal.
+	 */
+	ChangeJournal<int>& GetChanges() {
+		return changes;
 	}
 
 	std::string GetName(int _id) {
@@ -71,11 +138,28 @@ public:
 		variables.resize(Data::variables.size());
 
 		std::fill(variables.begin(), variables.end(), 0);
+		changes.Clear();
 	}
 
 private:
+	bool Resize(int variable_id) {
+		if (!isValidVar(variable_id)) {
+			if (variable_id > 0 && variable_id <= PLAYER_VAR_LIMIT) {
+				Output::Debug("Resizing variable array to %d elements.", variable_id);
+				variables.resize(variable_id);
+			}
+			else {
+				Output::Debug("Variable index %d is invalid.",
+					variable_id);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	std::vector<uint32_t>& variables;
-	int dummy;
+	ChangeJournal<int> changes;
 };
 
 #undef PLAYER_VAR_LIMIT
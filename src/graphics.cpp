@@ -17,6 +17,7 @@
 
 // Headers
 #include <algorithm>
+#include <cstdio>
 #include <sstream>
 #include <vector>
 #include <map>
@@ -26,15 +27,22 @@
 #include "cache.h"
 #include "baseui.h"
 #include "drawable.h"
+#include "input_latency.h"
 #include "util_macro.h"
 #include "player.h"
+#include "trace.h"
+#include "utils.h"
 
 namespace Graphics {
 	bool fps_on_screen;
+	bool profiler_on_screen;
+	FrameCounters frame_counters;
 
 	void UpdateTitle();
 	void DrawFrame();
 	void DrawOverlay();
+	void DrawProfiler();
+	void Present(uint64_t draw_start);
 
 	int fps;
 	int framerate;
@@ -62,6 +70,28 @@ namespace Graphics {
 
 	int real_fps;
 
+	/** Number of frames the frame pacing statistic covers. */
+	const size_t frame_stats_size = 600;
+
+	/** Ring buffers of the last frame_stats_size frames. */
+	std::vector<uint64_t> frame_intervals;
+	std::vector<uint8_t> frame_flags;
+	size_t frame_stats_pos;
+
+	enum FrameFlags {
+		FrameMissed = 1,
+		FrameSkipped = 2
+	};
+
+	/** Frames shown by the profiler graph, one pixel column each. */
+	const int profiler_frames = 120;
+
+	/** Phase times of the current frame and ring buffer of the graph. */
+	uint64_t phase_times[PhaseCount];
+	std::vector<uint64_t> profiler_history;
+	int profiler_pos;
+	FrameCounters last_frame_counters;
+
 	EASYRPG_SHARED_PTR<State> state;
 	std::vector<EASYRPG_SHARED_PTR<State> > stack;
 	EASYRPG_SHARED_PTR<State> global_state;
@@ -75,6 +105,7 @@ unsigned SecondToFrame(float const second) {
 
 void Graphics::Init() {
 	fps_on_screen = false;
+	SetProfilerOnScreen(false);
 	fps = 0;
 	frozen_screen = BitmapRef();
 	screen_erased = false;
@@ -86,6 +117,10 @@ void Graphics::Init() {
 	global_state.reset(new State());
 
 	next_fps_time = 0;
+
+	frame_intervals.clear();
+	frame_flags.clear();
+	frame_stats_pos = 0;
 }
 
 void Graphics::Quit() {
@@ -151,18 +186,27 @@ void Graphics::UpdateTitle() {
 }
 
 void Graphics::DrawFrame() {
+	TRACE_SCOPE("graphics", "Graphics::DrawFrame");
+
 	std::list<Drawable*>::iterator it_list;
+	uint64_t const draw_start = BeginPhase();
+	int drawn = 0;
 
 	if (transition_frames_left > 0) {
 		UpdateTransition();
 
 		for (it_list = global_state->drawable_list.begin(); it_list != global_state->drawable_list.end(); ++it_list) {
 			(*it_list)->Draw();
+			++drawn;
 		}
+		if (profiler_on_screen) {
+			frame_counters.drawables += drawn;
+		}
+		InputLatency::FrameDrawn(*DisplayUi->GetDisplaySurface());
 
 		DrawOverlay();
 
-		DisplayUi->UpdateDisplay();
+		Present(draw_start);
 		return;
 	}
 
@@ -184,15 +228,33 @@ void Graphics::DrawFrame() {
 
 	for (it_list = state->drawable_list.begin(); it_list != state->drawable_list.end(); ++it_list) {
 		(*it_list)->Draw();
+		++drawn;
 	}
 
 	for (it_list = global_state->drawable_list.begin(); it_list != global_state->drawable_list.end(); ++it_list) {
 		(*it_list)->Draw();
+		++drawn;
+	}
+	if (profiler_on_screen) {
+		frame_counters.drawables += drawn;
 	}
+	InputLatency::FrameDrawn(*DisplayUi->GetDisplaySurface());
 
 	DrawOverlay();
 
+	Present(draw_start);
+}
+
+void Graphics::Present(uint64_t draw_start) {
+	EndPhase(PhaseDraw, draw_start);
+
+	TRACE_SCOPE("graphics", "BaseUi::UpdateDisplay");
+
+	uint64_t const present_start = BeginPhase();
 	DisplayUi->UpdateDisplay();
+	EndPhase(PhasePresent, present_start);
+
+	InputLatency::FramePresented();
 }
 
 void Graphics::DrawOverlay() {
@@ -201,6 +263,73 @@ void Graphics::DrawOverlay() {
 		text << "FPS: " << real_fps;
 		DisplayUi->GetDisplaySurface()->TextDraw(2, 2, Color(255, 255, 255, 255), text.str());
 	}
+
+	if (profiler_on_screen) {
+		DrawProfiler();
+	}
+}
+
+void Graphics::DrawProfiler() {
+	static const char* const names[PhaseCount] = {
+		"Logic", "Interpreter", "Draw", "Present", "Sleep"
+	};
+	static const Color colors[PhaseCount] = {
+		Color(0, 200, 0, 255),
+		Color(230, 200, 0, 255),
+		Color(60, 120, 255, 255),
+		Color(200, 60, 200, 255),
+		Color(110, 110, 110, 255)
+	};
+	// Graph height is two frames at the default frame rate
+	static const int graph_height = 48;
+	static const double pixels_per_ns = graph_height * GetDefaultFps() / 2 / 1000000000.0;
+
+	BitmapRef surface = DisplayUi->GetDisplaySurface();
+	Color const white(255, 255, 255, 255);
+	int const frames = profiler_history.size() / PhaseCount;
+
+	// Phase legend with the mean of the graph
+	int y = 14;
+	for (int phase = 0; phase < PhaseCount; ++phase) {
+		uint64_t sum = 0;
+		for (int i = 0; i < frames; ++i) {
+			sum += profiler_history[i * PhaseCount + phase];
+		}
+
+		char text[32];
+		sprintf(text, "%-11s %6.2f ms", names[phase], frames > 0 ? sum / 1000000.0 / frames : 0.0);
+		surface->TextDraw(2, y, colors[phase], text);
+		y += 12;
+	}
+
+	std::stringstream counters;
+	counters << "Drawables " << last_frame_counters.drawables
+		<< "  Bitmaps " << last_frame_counters.bitmaps_created;
+	surface->TextDraw(2, y, white, counters.str());
+	y += 12;
+	counters.str("");
+	counters << "Cache hits " << last_frame_counters.cache_hits
+		<< "  misses " << last_frame_counters.cache_misses;
+	surface->TextDraw(2, y, white, counters.str());
+
+	// Stacked phase times, newest frame on the right
+	Rect const graph(2, surface->height() - graph_height - 2, profiler_frames, graph_height);
+	surface->FillRect(graph, Color(0, 0, 0, 255));
+	for (int i = 0; i < frames; ++i) {
+		int const frame = (profiler_pos + profiler_frames - frames + i) % profiler_frames;
+		int bottom = graph.y + graph.height;
+		for (int phase = 0; phase < PhaseCount && bottom > graph.y; ++phase) {
+			int height = (int)(profiler_history[frame * PhaseCount + phase] * pixels_per_ns + 0.5);
+			height = std::min(height, bottom - graph.y);
+			if (height > 0) {
+				surface->FillRect(Rect(graph.x + profiler_frames - frames + i, bottom - height, 1, height), colors[phase]);
+				bottom -= height;
+			}
+		}
+	}
+
+	// Frame budget line
+	surface->FillRect(Rect(graph.x, graph.y + graph.height / 2, graph.width, 1), white);
 }
 
 BitmapRef Graphics::SnapToBitmap() {
@@ -471,3 +600,80 @@ void Graphics::Pop() {
 int Graphics::GetDefaultFps() {
 	return DEFAULT_FPS;
 }
+
+void Graphics::RecordFrameTime(uint64_t interval_ns, bool missed, bool skipped) {
+	uint8_t flags = (missed ? FrameMissed : 0) | (skipped ? FrameSkipped : 0);
+
+	if (frame_intervals.size() < frame_stats_size) {
+		frame_intervals.push_back(interval_ns);
+		frame_flags.push_back(flags);
+	} else {
+		frame_intervals[frame_stats_pos] = interval_ns;
+		frame_flags[frame_stats_pos] = flags;
+		frame_stats_pos = (frame_stats_pos + 1) % frame_stats_size;
+	}
+}
+
+uint64_t Graphics::BeginPhase() {
+	return profiler_on_screen ? Utils::GetTimeNs() : 0;
+}
+
+void Graphics::EndPhase(FramePhase phase, uint64_t start) {
+	if (start != 0) {
+		phase_times[phase] += Utils::GetTimeNs() - start;
+	}
+}
+
+void Graphics::EndProfilerFrame() {
+	if (!profiler_on_screen) {
+		return;
+	}
+
+	// Interpreters run inside of the scene update
+	phase_times[PhaseLogic] -= std::min(phase_times[PhaseLogic], phase_times[PhaseInterpreter]);
+
+	if (profiler_history.size() < (size_t)(profiler_frames * PhaseCount)) {
+		profiler_history.insert(profiler_history.end(), phase_times, phase_times + PhaseCount);
+	} else {
+		std::copy(phase_times, phase_times + PhaseCount, profiler_history.begin() + profiler_pos * PhaseCount);
+	}
+	profiler_pos = (profiler_pos + 1) % profiler_frames;
+
+	std::fill(phase_times, phase_times + PhaseCount, 0);
+	last_frame_counters = frame_counters;
+	frame_counters = FrameCounters();
+}
+
+void Graphics::SetProfilerOnScreen(bool enabled) {
+	profiler_on_screen = enabled;
+
+	std::fill(phase_times, phase_times + PhaseCount, 0);
+	profiler_history.clear();
+	profiler_pos = 0;
+	frame_counters = FrameCounters();
+	last_frame_counters = FrameCounters();
+}
+
+Graphics::FrameStats Graphics::GetFrameStats() {
+	FrameStats stats;
+	if (frame_intervals.empty()) {
+		return stats;
+	}
+
+	uint64_t sum = 0;
+	for (size_t i = 0; i < frame_intervals.size(); ++i) {
+		sum += frame_intervals[i];
+		stats.max_ms = std::max(stats.max_ms, frame_intervals[i] / 1000000.0);
+		stats.missed += (frame_flags[i] & FrameMissed) ? 1 : 0;
+		stats.skipped += (frame_flags[i] & FrameSkipped) ? 1 : 0;
+	}
+	stats.frames = frame_intervals.size();
+	stats.mean_ms = sum / 1000000.0 / stats.frames;
+
+	std::vector<uint64_t> sorted = frame_intervals;
+	std::vector<uint64_t>::iterator p99 = sorted.begin() + (sorted.size() - 1) * 99 / 100;
+	std::nth_element(sorted.begin(), p99, sorted.end());
+	stats.p99_ms = *p99 / 1000000.0;
+
+	return stats;
+}
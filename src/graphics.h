@@ -139,6 +139,100 @@ namespace Graphics {
 	 * @return target frame rate
 	 */
 	int GetDefaultFps();
+
+	/** Frame pacing statistic of the last frames. */
+	struct FrameStats {
+		FrameStats() : frames(0), mean_ms(0), p99_ms(0), max_ms(0), missed(0), skipped(0) {}
+
+		/** Number of frames the statistic covers. */
+		int frames;
+		/** Frame interval mean, 99th percentile and maximum. */
+		double mean_ms;
+		double p99_ms;
+		double max_ms;
+		/** Frames which finished after their deadline. */
+		int missed;
+		/** Frames whose rendering was skipped to catch up. */
+		int skipped;
+	};
+
+	/**
+	 * Adds a frame to the frame pacing statistic.
+	 * Called by Player::Update once per frame.
+	 *
+	 * @param interval_ns time since the previous frame in nanoseconds.
+	 * @param missed whether the frame missed its deadline.
+	 * @param skipped whether rendering was skipped.
+	 */
+	void RecordFrameTime(uint64_t interval_ns, bool missed, bool skipped);
+
+	/**
+	 * Gets the frame pacing statistic of the last frames.
+	 *
+	 * @return frame statistic.
+	 */
+	FrameStats GetFrameStats();
+
+	/** Parts of a frame shown by the profiler overlay. */
+	enum FramePhase {
+		/** Scene update without the interpreters */
+		PhaseLogic,
+		PhaseInterpreter,
+		/** Drawing into the display surface */
+		PhaseDraw,
+		/** DisplayUi::UpdateDisplay */
+		PhasePresent,
+		/** Waiting for the next frame */
+		PhaseSleep,
+		PhaseCount
+	};
+
+	/** Per frame counters of the profiler overlay. */
+	struct FrameCounters {
+		FrameCounters() : drawables(0), bitmaps_created(0), cache_hits(0), cache_misses(0) {}
+
+		int drawables;
+		int bitmaps_created;
+		int cache_hits;
+		int cache_misses;
+	};
+
+	/**
+	 * Whether the frame profiler overlay is shown.
+	 * Phases and counters are only measured while it is.
+	 */
+	extern bool profiler_on_screen;
+
+	/** Counters of the current frame, only updated while profiler_on_screen. */
+	extern FrameCounters frame_counters;
+
+	/**
+	 * Starts timing a frame phase.
+	 *
+	 * @return start time for EndPhase, 0 when the profiler is off.
+	 */
+	uint64_t BeginPhase();
+
+	/**
+	 * Adds the time since BeginPhase to a phase of the current frame.
+	 *
+	 * @param phase frame phase.
+	 * @param start return value of BeginPhase.
+	 */
+	void EndPhase(FramePhase phase, uint64_t start);
+
+	/**
+	 * Moves the phases and counters of the current frame into the
+	 * overlay graph. Called by Player::Update once per frame.
+	 */
+	void EndProfilerFrame();
+
+	/**
+	 * Shows or hides the profiler overlay.
+	 *
+	 * @param enabled whether to show the overlay.
+	 */
+	void SetProfilerOnScreen(bool enabled);
 }
 
 #endif
@@ -26,6 +26,7 @@
 #include <vector>
 #include "output.h"
 #include "image_bmp.h"
+#include "trace.h"
 
 static uint16_t get_2(const uint8_t *p)
 {
@@ -45,6 +46,8 @@ static uint32_t get_4(const uint8_t *p)
 
 void ImageBMP::ReadBMP(const uint8_t* data, unsigned len, bool transparent,
 					   int& width, int& height, void*& pixels) {
+	TRACE_SCOPE("image", "ImageBMP::ReadBMP");
+
 	pixels = NULL;
 
 	// BITMAPFILEHEADER structure
@@ -140,6 +143,8 @@ void ImageBMP::ReadBMP(const uint8_t* data, unsigned len, bool transparent,
 
 void ImageBMP::ReadBMP(FILE* stream, bool transparent,
 					int& width, int& height, void*& pixels) {
+	TRACE_SCOPE("file", "ImageBMP::ReadFile");
+
 	fseek(stream, 0, SEEK_END);
 	long size = ftell(stream);
 	fseek(stream, 0, SEEK_SET);
@@ -27,6 +27,7 @@
 
 #include "output.h"
 #include "image_png.h"
+#include "trace.h"
 
 static void read_data(png_structp png_ptr, png_bytep data, png_size_t length) {
     png_bytep* bufp = (png_bytep*) png_get_io_ptr(png_ptr);
@@ -50,6 +51,8 @@ static void ReadRGBAData(png_struct*, png_info*, png_uint_32, png_uint_32, uint3
 
 void ImagePNG::ReadPNG(FILE* stream, const void* buffer, bool transparent,
 					int& width, int& height, void*& pixels) {
+	TRACE_SCOPE("image", "ImagePNG::ReadPNG");
+
 	pixels = NULL;
 
 	png_struct *png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, on_png_error, on_png_warning);
@@ -25,9 +25,12 @@
 #include <vector>
 #include "output.h"
 #include "image_xyz.h"
+#include "trace.h"
 
 void ImageXYZ::ReadXYZ(const uint8_t* data, unsigned len, bool transparent,
 					int& width, int& height, void*& pixels) {
+	TRACE_SCOPE("image", "ImageXYZ::ReadXYZ");
+
 	pixels = NULL;
 
     if (len < 8 || strncmp((char *) data, "XYZ1", 4) != 0) {
@@ -70,6 +73,8 @@ void ImageXYZ::ReadXYZ(const uint8_t* data, unsigned len, bool transparent,
 
 void ImageXYZ::ReadXYZ(FILE* stream, bool transparent,
 					int& width, int& height, void*& pixels) {
+	TRACE_SCOPE("file", "ImageXYZ::ReadFile");
+
     fseek(stream, 0, SEEK_END);
     long size = ftell(stream);
     fseek(stream, 0, SEEK_SET);
@@ -17,10 +17,16 @@
 
 // Headers
 #include "input.h"
+#include "input_latency.h"
+#include "filefinder.h"
+#include "output.h"
 #include "player.h"
 #include "system.h"
 
 #include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
 #include <boost/lambda/lambda.hpp>
 
 namespace Input {
@@ -34,6 +40,85 @@ namespace Input {
 	std::vector<std::vector<int> > dir_buttons;
 
 	bool wait_input = false;
+
+	const char* const LOG_HEADER = "EasyRPG input log 1";
+
+	/** Number of Update calls, the frame numbers of the input log. */
+	int update_count = 0;
+
+	EASYRPG_SHARED_PTR<std::fstream> record_log;
+	std::bitset<BUTTON_COUNT> recorded_buttons;
+
+	/** Buttons pressed by SimulateButtonPress for the next Update. */
+	std::bitset<BUTTON_COUNT> simulated_buttons;
+
+	/** Line of the input log. */
+	struct LogEntry {
+		enum Type {
+			/** Buttons pressed from frame on */
+			Buttons,
+			/** ResetKeys before frame */
+			Reset,
+			/** Last frame of the log */
+			End
+		};
+
+		int frame;
+		Type type;
+		std::bitset<BUTTON_COUNT> buttons;
+	};
+
+	bool replaying = false;
+	std::vector<LogEntry> replay_log;
+	size_t replay_pos;
+	std::bitset<BUTTON_COUNT> replay_buttons;
+
+	void ResetButtons() {
+		triggered.reset();
+		repeated.reset();
+		released.reset();
+		for (unsigned i = 0; i < BUTTON_COUNT; i++) {
+			press_time[i] = 0;
+		}
+		dir4 = 0;
+		dir8 = 0;
+	}
+
+	void RecordButtons(const std::bitset<BUTTON_COUNT>& pressed) {
+		if (pressed == recorded_buttons) {
+			return;
+		}
+		recorded_buttons = pressed;
+
+		*record_log << update_count << " buttons";
+		for (unsigned i = 0; i < BUTTON_COUNT; ++i) {
+			if (pressed[i]) {
+				*record_log << " " << i;
+			}
+		}
+		*record_log << "\n";
+	}
+
+	std::bitset<BUTTON_COUNT> ReplayButtons() {
+		for (; replay_pos < replay_log.size() && replay_log[replay_pos].frame <= update_count; ++replay_pos) {
+			const LogEntry& entry = replay_log[replay_pos];
+			switch (entry.type) {
+				case LogEntry::Buttons:
+					replay_buttons = entry.buttons;
+					break;
+				case LogEntry::Reset:
+					// Recorded reset without a matching ResetKeys call
+					ResetButtons();
+					break;
+				case LogEntry::End:
+					Output::Debug("Input replay finished after %d frames", update_count);
+					replaying = false;
+					Player::exit_flag = true;
+					break;
+			}
+		}
+		return replay_buttons;
+	}
 }
 
 bool Input::IsWaitingInput() { return wait_input; }
@@ -56,19 +141,31 @@ void Input::Update() {
 
 	BaseUi::KeyStatus& keystates = DisplayUi->GetKeyStates();
 
-	// Check button states
-	for (unsigned i = 0; i < BUTTON_COUNT; ++i) {
-		bool pressed = false;
-
+	std::bitset<BUTTON_COUNT> pressed;
+	if (replaying) {
+		pressed = ReplayButtons();
+	} else {
 		// Check state of keys assigned to button
-		for (unsigned e = 0; e < buttons[i].size(); e++) {
-			if (keystates[buttons[i][e]]) {
-				pressed = true;
-				break;
+		for (unsigned i = 0; i < BUTTON_COUNT; ++i) {
+			for (unsigned e = 0; e < buttons[i].size(); e++) {
+				if (keystates[buttons[i][e]]) {
+					pressed[i] = true;
+					break;
+				}
 			}
 		}
+		pressed |= simulated_buttons;
+
+		if (record_log) {
+			RecordButtons(pressed);
+		}
+	}
+	simulated_buttons.reset();
+	++update_count;
 
-		if (pressed) {
+	// Check button states
+	for (unsigned i = 0; i < BUTTON_COUNT; ++i) {
+		if (pressed[i]) {
 			released[i] = false;
 			press_time[i] += 1;
 		} else {
@@ -84,6 +181,7 @@ void Input::Update() {
 			repeated[i] = false;
 		}
 	}
+	InputLatency::InputRead(triggered.any());
 
 	// Press time for directional buttons, the less they have been pressed, the higher their priority will be
 	int dirpress[10];
@@ -132,16 +230,98 @@ void Input::Update() {
 }
 
 void Input::ResetKeys() {
-	triggered.reset();
-	repeated.reset();
-	released.reset();
-	for (unsigned i = 0; i < BUTTON_COUNT; i++) {
-		press_time[i] = 0;
+	DisplayUi->GetKeyStates().reset();
+
+	// A replay only resets where the recording did, the buttons are
+	// reset right away like in the recording
+	if (replaying) {
+		if (replay_pos < replay_log.size()
+			&& replay_log[replay_pos].type == LogEntry::Reset
+			&& replay_log[replay_pos].frame == update_count) {
+			++replay_pos;
+			ResetButtons();
+		}
+		return;
 	}
-	dir4 = 0;
-	dir8 = 0;
 
-	DisplayUi->GetKeyStates().reset();
+	if (record_log) {
+		*record_log << update_count << " reset\n";
+	}
+
+	ResetButtons();
+}
+
+void Input::SimulateButtonPress(InputButton button) {
+	simulated_buttons[button] = true;
+}
+
+bool Input::StartRecording(const std::string& file, unsigned seed) {
+	record_log = FileFinder::openUTF8(file, std::ios_base::out | std::ios_base::trunc);
+	if (!record_log) {
+		Output::Warning("Cannot write input log %s", file.c_str());
+		return false;
+	}
+
+	*record_log << LOG_HEADER << "\n";
+	*record_log << "seed " << seed << "\n";
+	recorded_buttons.reset();
+	return true;
+}
+
+void Input::StopRecording() {
+	if (!record_log) {
+		return;
+	}
+
+	*record_log << update_count << " end\n";
+	record_log.reset();
+}
+
+bool Input::StartReplay(const std::string& file, unsigned& seed) {
+	EASYRPG_SHARED_PTR<std::fstream> in = FileFinder::openUTF8(file, std::ios_base::in);
+	std::string line;
+	if (!in || !std::getline(*in, line) || line != LOG_HEADER) {
+		Output::Warning("Cannot read input log %s", file.c_str());
+		return false;
+	}
+
+	replay_log.clear();
+	while (std::getline(*in, line)) {
+		std::istringstream ss(line);
+		std::string type;
+		if (line.compare(0, 5, "seed ") == 0) {
+			ss >> type >> seed;
+			continue;
+		}
+
+		LogEntry entry;
+		if (!(ss >> entry.frame >> type)) {
+			continue;
+		}
+
+		if (type == "buttons") {
+			entry.type = LogEntry::Buttons;
+			unsigned button;
+			while (ss >> button) {
+				if (button < BUTTON_COUNT) {
+					entry.buttons[button] = true;
+				}
+			}
+		} else if (type == "reset") {
+			entry.type = LogEntry::Reset;
+		} else if (type == "end") {
+			entry.type = LogEntry::End;
+		} else {
+			continue;
+		}
+		replay_log.push_back(entry);
+	}
+
+	replaying = true;
+	replay_pos = 0;
+	replay_buttons.reset();
+	Output::Debug("Replaying %d input log entries from %s", (int)replay_log.size(), file.c_str());
+	return true;
 }
 
 bool Input::IsPressed(InputButton button) {
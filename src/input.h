@@ -19,6 +19,7 @@
 #define _EASY_INPUT_H_
 
 // Headers
+#include <string>
 #include <vector>
 #include <bitset>
 #include "system.h"
@@ -45,9 +46,42 @@ namespace Input {
 
 	/**
 	 * Resets all button states.
+	 * While replaying only resets that were recorded are applied.
 	 */
 	void ResetKeys();
 
+	/**
+	 * Records the pressed buttons of every frame to a log file.
+	 *
+	 * @param file log file name.
+	 * @param seed random number generator seed stored in the log.
+	 * @return whether the log file could be created.
+	 */
+	bool StartRecording(const std::string& file, unsigned seed);
+
+	/**
+	 * Finishes the recording started by StartRecording.
+	 */
+	void StopRecording();
+
+	/**
+	 * Replays a log of StartRecording instead of reading the keys.
+	 * Sets Player::exit_flag when the end of the log is reached.
+	 *
+	 * @param file log file name.
+	 * @param seed receives the random number generator seed of the log.
+	 * @return whether the log could be read.
+	 */
+	bool StartReplay(const std::string& file, unsigned& seed);
+
+	/**
+	 * Presses a button during the next Update in addition to the keys.
+	 * Hold a button by calling this before every Update.
+	 *
+	 * @param button button ID.
+	 */
+	void SimulateButtonPress(InputButton button);
+
 	/**
 	 * Gets if a button is being pressed.
 	 *
@@ -55,6 +55,8 @@ namespace Input {
 		TOGGLE_FPS,
 		TAKE_SCREENSHOT,
 		SHOW_LOG,
+		TOGGLE_PROFILER,
+		DUMP_TRACE,
 		BUTTON_COUNT
 	};
 
@@ -72,6 +72,8 @@ void Input::InitButtons() {
 	buttons[TAKE_SCREENSHOT].push_back(Keys::F10);
 	buttons[TOGGLE_FPS].push_back(Keys::F2);
 	buttons[SHOW_LOG].push_back(Keys::F3);
+	buttons[TOGGLE_PROFILER].push_back(Keys::F6);
+	buttons[DUMP_TRACE].push_back(Keys::F7);
 
 #if defined(USE_MOUSE) && defined(SUPPORT_MOUSE)
 	buttons[DECISION].push_back(Keys::MOUSE_LEFT);
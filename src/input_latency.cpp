@@ -0,0 +1,173 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include <algorithm>
+#include <vector>
+#include "input_latency.h"
+#include "bitmap.h"
+#include "output.h"
+#include "utils.h"
+
+namespace {
+	/** Drawn frames without visible change after which a sample is dropped. */
+	const int max_sample_frames = 60;
+
+	struct Sample {
+		uint64_t event_to_input;
+		uint64_t input_to_scene;
+		uint64_t scene_to_present;
+		uint64_t total;
+	};
+
+	bool enabled = false;
+	std::vector<Sample> samples;
+	int dropped = 0;
+
+	/** Earliest key event since the last Input::Update, 0 if none. */
+	uint64_t event_time = 0;
+
+	/** Checksum of the last drawn frame. */
+	uint32_t frame_checksum = 0;
+
+	bool in_flight = false;
+	bool changed = false;
+	int sample_frames;
+	uint32_t sample_checksum;
+	uint64_t sample_event;
+	uint64_t sample_input;
+	uint64_t sample_scene;
+
+	/** FNV-1a over the visible pixels. */
+	uint32_t Checksum(const Bitmap& surface) {
+		int const row_bytes = surface.width() * surface.bpp();
+		uint32_t hash = 2166136261u;
+		for (int y = 0; y < surface.height(); ++y) {
+			const uint8_t* row = (const uint8_t*)surface.pixels() + y * surface.pitch();
+			for (int x = 0; x < row_bytes; ++x) {
+				hash = (hash ^ row[x]) * 16777619u;
+			}
+		}
+		return hash;
+	}
+
+	void ReportStage(const char* name, std::vector<uint64_t> values) {
+		std::sort(values.begin(), values.end());
+		size_t const p99 = std::min(values.size() - 1, values.size() * 99 / 100);
+		Output::Debug("Input latency %-16s min %6.2f ms, median %6.2f ms, p99 %6.2f ms", name,
+			values.front() / 1000000.0, values[values.size() / 2] / 1000000.0, values[p99] / 1000000.0);
+	}
+}
+
+void InputLatency::SetEnabled(bool enable) {
+	enabled = enable;
+	in_flight = false;
+	event_time = 0;
+}
+
+bool InputLatency::IsEnabled() {
+	return enabled;
+}
+
+void InputLatency::KeyEvent(uint64_t age_ns) {
+	if (!enabled || event_time != 0) {
+		return;
+	}
+	event_time = Utils::GetTimeNs() - age_ns;
+}
+
+void InputLatency::InputRead(bool triggered) {
+	if (!enabled) {
+		return;
+	}
+
+	if (triggered && !in_flight) {
+		in_flight = true;
+		changed = false;
+		sample_frames = 0;
+		sample_checksum = frame_checksum;
+		sample_input = Utils::GetTimeNs();
+		// Simulated and replayed input has no key event
+		sample_event = event_time != 0 ? event_time : sample_input;
+		sample_scene = 0;
+	}
+	event_time = 0;
+}
+
+void InputLatency::SceneUpdated() {
+	if (in_flight && sample_scene == 0) {
+		sample_scene = Utils::GetTimeNs();
+	}
+}
+
+void InputLatency::FrameDrawn(const Bitmap& surface) {
+	if (!enabled) {
+		return;
+	}
+
+	frame_checksum = Checksum(surface);
+	if (!in_flight || changed) {
+		return;
+	}
+
+	if (frame_checksum != sample_checksum) {
+		changed = true;
+	} else if (++sample_frames >= max_sample_frames) {
+		in_flight = false;
+		++dropped;
+	}
+}
+
+void InputLatency::FramePresented() {
+	if (!in_flight || !changed) {
+		return;
+	}
+	in_flight = false;
+
+	uint64_t const now = Utils::GetTimeNs();
+	uint64_t const scene = sample_scene != 0 ? sample_scene : sample_input;
+	Sample sample;
+	sample.event_to_input = sample_input - sample_event;
+	sample.input_to_scene = scene - sample_input;
+	sample.scene_to_present = now - scene;
+	sample.total = now - sample_event;
+	samples.push_back(sample);
+}
+
+void InputLatency::Report() {
+	if (!enabled) {
+		return;
+	}
+
+	Output::Debug("Input latency: %d samples, %d inputs without visible change",
+		(int)samples.size(), dropped);
+	if (samples.empty()) {
+		return;
+	}
+
+	std::vector<uint64_t> total, event_to_input, input_to_scene, scene_to_present;
+	for (std::vector<Sample>::const_iterator it = samples.begin(); it != samples.end(); ++it) {
+		total.push_back(it->total);
+		event_to_input.push_back(it->event_to_input);
+		input_to_scene.push_back(it->input_to_scene);
+		scene_to_present.push_back(it->scene_to_present);
+	}
+	ReportStage("total", total);
+	ReportStage("event to input", event_to_input);
+	ReportStage("input to scene", input_to_scene);
+	ReportStage("scene to display", scene_to_present);
+}
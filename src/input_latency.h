@@ -0,0 +1,89 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INPUT_LATENCY_H_
+#define _INPUT_LATENCY_H_
+
+// Headers
+#include "system.h"
+
+class Bitmap;
+
+/**
+ * InputLatency measures the time from a pressed key until the display
+ * shows a reaction to it. A sample starts when Input::Update reads a newly
+ * triggered button and ends with the present of the first frame that
+ * differs from the frame on screen at that time. Overlays are not part of
+ * the comparison. Animations running independently of the input end a
+ * sample as well, so only a scene idle before the key press gives exact
+ * results.
+ *
+ * Each sample is split into the stages key event to Input::Update,
+ * Input::Update to the end of the scene update and scene update to the
+ * display update.
+ */
+namespace InputLatency {
+	/**
+	 * Enables or disables the measurement.
+	 *
+	 * @param enabled whether latency is measured.
+	 */
+	void SetEnabled(bool enabled);
+
+	/**
+	 * @return whether latency is measured.
+	 */
+	bool IsEnabled();
+
+	/**
+	 * Called by the UI when a key or button down event is received.
+	 *
+	 * @param age_ns time the event waited in the event queue when known.
+	 */
+	void KeyEvent(uint64_t age_ns = 0);
+
+	/**
+	 * Called by Input::Update after reading the buttons.
+	 *
+	 * @param triggered whether a button was newly pressed.
+	 */
+	void InputRead(bool triggered);
+
+	/**
+	 * Called after the scene update of a frame.
+	 */
+	void SceneUpdated();
+
+	/**
+	 * Called after the scene was drawn, before the overlays.
+	 *
+	 * @param surface display surface.
+	 */
+	void FrameDrawn(const Bitmap& surface);
+
+	/**
+	 * Called after the display was updated.
+	 */
+	void FramePresented();
+
+	/**
+	 * Writes min, median and p99 of the latency and its stages to the log.
+	 */
+	void Report();
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <map>
+#include "interpreter_profiler.h"
+#include "filefinder.h"
+#include "output.h"
+
+namespace {
+	bool enabled = false;
+	std::string output_file;
+
+	/** { map_id, event_id, common_event_id, code } */
+	struct Key {
+		Key(int map_id, int event_id, int common_event_id, int code) :
+			map_id(map_id), event_id(event_id), common_event_id(common_event_id), code(code) {}
+
+		bool operator<(const Key& other) const {
+			if (map_id != other.map_id) return map_id < other.map_id;
+			if (event_id != other.event_id) return event_id < other.event_id;
+			if (common_event_id != other.common_event_id) return common_event_id < other.common_event_id;
+			return code < other.code;
+		}
+
+		int map_id, event_id, common_event_id, code;
+	};
+
+	typedef std::map<Key, InterpreterProfiler::Entry> entry_map;
+
+	/** Statistic per event and command code */
+	entry_map commands;
+	/** Statistic per event, code is always 0 */
+	entry_map limits;
+
+	InterpreterProfiler::Entry& GetEntry(entry_map& entries, const Key& key) {
+		InterpreterProfiler::Entry& entry = entries[key];
+		entry.map_id = key.map_id;
+		entry.event_id = key.event_id;
+		entry.common_event_id = key.common_event_id;
+		entry.code = key.code;
+		return entry;
+	}
+
+	bool SlowerThan(const InterpreterProfiler::Entry& a, const InterpreterProfiler::Entry& b) {
+		return a.time_ns > b.time_ns;
+	}
+
+	std::vector<InterpreterProfiler::Entry> Collect(bool by_command) {
+		entry_map totals;
+		for (entry_map::const_iterator i = commands.begin(); i != commands.end(); ++i) {
+			const Key& key = i->first;
+			InterpreterProfiler::Entry& total = by_command ?
+				GetEntry(totals, Key(0, 0, 0, key.code)) :
+				GetEntry(totals, Key(key.map_id, key.event_id, key.common_event_id, 0));
+			total.executions += i->second.executions;
+			total.time_ns += i->second.time_ns;
+		}
+
+		if (!by_command) {
+			for (entry_map::const_iterator i = limits.begin(); i != limits.end(); ++i) {
+				GetEntry(totals, i->first).limit_frames += i->second.limit_frames;
+			}
+		}
+
+		std::vector<InterpreterProfiler::Entry> result;
+		result.reserve(totals.size());
+		for (entry_map::const_iterator i = totals.begin(); i != totals.end(); ++i) {
+			result.push_back(i->second);
+		}
+		std::stable_sort(result.begin(), result.end(), SlowerThan);
+		return result;
+	}
+}
+
+void InterpreterProfiler::SetEnabled(bool enable) {
+	enabled = enable;
+}
+
+bool InterpreterProfiler::IsEnabled() {
+	return enabled;
+}
+
+void InterpreterProfiler::SetOutputFile(const std::string& file) {
+	output_file = file;
+	enabled = true;
+}
+
+void InterpreterProfiler::RecordCommand(int map_id, int event_id, int common_event_id, int code, uint64_t time_ns) {
+	Entry& entry = GetEntry(commands, Key(map_id, event_id, common_event_id, code));
+	++entry.executions;
+	entry.time_ns += time_ns;
+}
+
+void InterpreterProfiler::RecordLimitExceeded(int map_id, int event_id, int common_event_id) {
+	++GetEntry(limits, Key(map_id, event_id, common_event_id, 0)).limit_frames;
+}
+
+std::vector<InterpreterProfiler::Entry> InterpreterProfiler::GetEvents() {
+	return Collect(false);
+}
+
+std::vector<InterpreterProfiler::Entry> InterpreterProfiler::GetCommands() {
+	return Collect(true);
+}
+
+void InterpreterProfiler::Reset() {
+	commands.clear();
+	limits.clear();
+}
+
+void InterpreterProfiler::Quit() {
+	if (output_file.empty()) {
+		return;
+	}
+
+	EASYRPG_SHARED_PTR<std::fstream> out = FileFinder::openUTF8(output_file, std::ios_base::out | std::ios_base::trunc);
+	if (!out) {
+		Output::Debug("Cannot write profile %s", output_file.c_str());
+		return;
+	}
+
+	// Event totals carry the limit frames and "total" as code,
+	// the rows below them split the time by command code.
+	*out << "map_id,event_id,common_event_id,code,executions,time_us,limit_frames\n";
+
+	std::vector<Entry> events = GetEvents();
+	for (std::vector<Entry>::const_iterator i = events.begin(); i != events.end(); ++i) {
+		*out << i->map_id << "," << i->event_id << "," << i->common_event_id << ",total,"
+			<< i->executions << "," << i->time_ns / 1000 << "," << i->limit_frames << "\n";
+
+		entry_map::const_iterator cmd = commands.lower_bound(Key(i->map_id, i->event_id, i->common_event_id, INT_MIN));
+		for (; cmd != commands.end() && cmd->first.map_id == i->map_id && cmd->first.event_id == i->event_id &&
+			cmd->first.common_event_id == i->common_event_id; ++cmd) {
+			*out << i->map_id << "," << i->event_id << "," << i->common_event_id << "," << cmd->first.code << ","
+				<< cmd->second.executions << "," << cmd->second.time_ns / 1000 << ",0\n";
+		}
+	}
+
+	Output::Debug("Wrote interpreter profile of %d events to %s", (int)events.size(), output_file.c_str());
+}
@@ -0,0 +1,114 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INTERPRETER_PROFILER_H_
+#define _INTERPRETER_PROFILER_H_
+
+// Headers
+#include <string>
+#include <vector>
+#include "system.h"
+
+/**
+ * InterpreterProfiler collects how much time event interpreters spend in
+ * each event and event command. Recording is disabled by default and costs
+ * a single flag check per command then.
+ */
+namespace InterpreterProfiler {
+	/**
+	 * Accumulated statistic of an event or an event command.
+	 * Map events have a event_id, common events a common_event_id.
+	 */
+	struct Entry {
+		Entry() : map_id(0), event_id(0), common_event_id(0), code(0), executions(0), time_ns(0), limit_frames(0) {}
+
+		int map_id;
+		int event_id;
+		int common_event_id;
+		/** Command code, 0 for the end of the event list and event totals. */
+		int code;
+		int executions;
+		uint64_t time_ns;
+		/** Frames in which the event hit the execution limit. */
+		int limit_frames;
+	};
+
+	/**
+	 * Enables or disables recording.
+	 *
+	 * @param enabled whether commands are recorded.
+	 */
+	void SetEnabled(bool enabled);
+
+	/**
+	 * @return whether commands are recorded.
+	 */
+	bool IsEnabled();
+
+	/**
+	 * Enables recording and writes the statistic as CSV to file on Quit.
+	 *
+	 * @param file CSV file name.
+	 */
+	void SetOutputFile(const std::string& file);
+
+	/**
+	 * Adds the execution of a command to the statistic.
+	 *
+	 * @param map_id map the interpreter was started on.
+	 * @param event_id map event ID, 0 for common events.
+	 * @param common_event_id common event ID, 0 for map events.
+	 * @param code command code.
+	 * @param time_ns execution time in nanoseconds.
+	 */
+	void RecordCommand(int map_id, int event_id, int common_event_id, int code, uint64_t time_ns);
+
+	/**
+	 * Counts a frame in which an event exceeded the execution limit.
+	 *
+	 * @param map_id map the interpreter was started on.
+	 * @param event_id map event ID, 0 for common events.
+	 * @param common_event_id common event ID, 0 for map events.
+	 */
+	void RecordLimitExceeded(int map_id, int event_id, int common_event_id);
+
+	/**
+	 * Gets the totals of all events, slowest first.
+	 *
+	 * @return event statistic, code is 0.
+	 */
+	std::vector<Entry> GetEvents();
+
+	/**
+	 * Gets the totals of all command codes, slowest first.
+	 *
+	 * @return command statistic, only code, executions and time_ns are set.
+	 */
+	std::vector<Entry> GetCommands();
+
+	/**
+	 * Discards the collected statistic.
+	 */
+	void Reset();
+
+	/**
+	 * Writes the CSV file when one was set.
+	 */
+	void Quit();
+}
+
+#endif
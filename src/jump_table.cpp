@@ -0,0 +1,126 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "jump_table.h"
+#include "command_codes.h"
+
+namespace {
+	/** Keyed by the command list, which stays alive until ClearCache. */
+	typedef std::map<const std::vector<RPG::EventCommand>*, JumpTableRef> table_cache_type;
+	table_cache_type table_cache;
+}
+
+JumpTableRef JumpTable::Get(const std::vector<RPG::EventCommand>& list) {
+	JumpTableRef& table = table_cache[&list];
+	if (!table || table->commands.size() != list.size()) {
+		table = Create(list);
+	}
+	return table;
+}
+
+JumpTableRef JumpTable::Create(const std::vector<RPG::EventCommand>& list) {
+	return JumpTableRef(new JumpTable(list));
+}
+
+void JumpTable::ClearCache() {
+	table_cache.clear();
+}
+
+JumpTable::JumpTable(const std::vector<RPG::EventCommand>& list) :
+	commands(list.size()) {
+	int const size = (int)list.size();
+
+	for (int i = 0; i < size; ++i) {
+		commands[i].code = list[i].code;
+		commands[i].indent = list[i].indent;
+
+		if (list[i].code == Cmd::Label && !list[i].parameters.empty()) {
+			// The first label with an ID wins
+			labels.insert(std::make_pair(list[i].parameters[0], i));
+		}
+	}
+
+	// Commands waiting for their next command with the same or a lower indent
+	std::vector<int> open;
+	for (int i = 0; i < size; ++i) {
+		while (!open.empty() && commands[open.back()].indent >= commands[i].indent) {
+			commands[open.back()].next = i;
+			open.pop_back();
+		}
+		open.push_back(i);
+	}
+	for (std::vector<int>::iterator it = open.begin(); it != open.end(); ++it) {
+		commands[*it].next = size;
+	}
+
+	open.clear();
+	for (int i = size - 1; i >= 0; --i) {
+		while (!open.empty() && commands[open.back()].indent >= commands[i].indent) {
+			commands[open.back()].previous = i;
+			open.pop_back();
+		}
+		open.push_back(i);
+	}
+	for (std::vector<int>::iterator it = open.begin(); it != open.end(); ++it) {
+		commands[*it].previous = -1;
+	}
+}
+
+bool JumpTable::SkipTo(int& index, int code, int code2, int min_indent, int max_indent, bool otherwise_end) const {
+	int const size = (int)commands.size();
+
+	int idx;
+	for (idx = index; idx < size;) {
+		int const indent = commands[idx].indent;
+		if (indent < min_indent)
+			return false;
+		if (indent <= max_indent &&
+			(commands[idx].code == code || commands[idx].code == code2)) {
+			index = idx;
+			return true;
+		}
+		// Commands nested deeper than max_indent never match, skip them
+		idx = indent >= max_indent ? commands[idx].next : idx + 1;
+	}
+
+	if (otherwise_end)
+		index = idx;
+
+	return true;
+}
+
+bool JumpTable::FindLoop(int& index) const {
+	int const indent = commands[index].indent;
+
+	// Only commands with the same or a lower indent are visited
+	for (int idx = index; idx >= 0; idx = commands[idx].previous) {
+		if (commands[idx].indent < indent)
+			return false;
+		if (commands[idx].code == Cmd::Loop) {
+			index = idx;
+			break;
+		}
+	}
+
+	return true;
+}
+
+int JumpTable::FindLabel(int label_id) const {
+	std::map<int, int>::const_iterator it = labels.find(label_id);
+	return it == labels.end() ? -1 : it->second;
+}
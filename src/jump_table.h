@@ -0,0 +1,110 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _JUMP_TABLE_H_
+#define _JUMP_TABLE_H_
+
+// Headers
+#include <map>
+#include <vector>
+#include "rpg_eventcommand.h"
+#include "system.h"
+
+class JumpTable;
+typedef EASYRPG_SHARED_PTR<const JumpTable> JumpTableRef;
+
+/**
+ * Control flow information of an event command list.
+ * Lets the interpreter skip nested blocks and find labels without walking
+ * every command. Tables are built once per command list and shared between
+ * all interpreters running it.
+ */
+class JumpTable {
+public:
+	/**
+	 * Gets the jump table of a command list owned by the database or by a
+	 * map event. The table is built on the first request and kept until
+	 * ClearCache, the list must not change meanwhile.
+	 *
+	 * @param list event commands.
+	 * @return jump table.
+	 */
+	static JumpTableRef Get(const std::vector<RPG::EventCommand>& list);
+
+	/**
+	 * Builds a jump table without caching it, for command lists that are
+	 * not owned by the database or by a map event.
+	 *
+	 * @param list event commands.
+	 * @return jump table.
+	 */
+	static JumpTableRef Create(const std::vector<RPG::EventCommand>& list);
+
+	/**
+	 * Forgets all cached tables.
+	 * Called when the map events and their command lists are replaced.
+	 */
+	static void ClearCache();
+
+	/**
+	 * Searches forward for a command, see Game_Interpreter::SkipTo.
+	 * Commands nested deeper than max_indent are skipped as whole blocks.
+	 *
+	 * @param index start index, set to the found command.
+	 * @param code command code to find.
+	 * @param code2 alternative command code to find.
+	 * @param min_indent the search fails at a command with a lower indent.
+	 * @param max_indent commands with a higher indent do not match.
+	 * @param otherwise_end set index to the list size when nothing matched.
+	 * @return false when a command with a lower indent than min_indent ended
+	 *         the search.
+	 */
+	bool SkipTo(int& index, int code, int code2, int min_indent, int max_indent, bool otherwise_end) const;
+
+	/**
+	 * Searches backward for the Loop command of an EndLoop command.
+	 *
+	 * @param index EndLoop command index, set to the found Loop.
+	 * @return false when a command with a lower indent ended the search.
+	 */
+	bool FindLoop(int& index) const;
+
+	/**
+	 * Finds the first label command with an ID.
+	 *
+	 * @param label_id label ID.
+	 * @return command index or -1 when the label does not exist.
+	 */
+	int FindLabel(int label_id) const;
+
+private:
+	explicit JumpTable(const std::vector<RPG::EventCommand>& list);
+
+	struct Command {
+		int code;
+		int indent;
+		/** Next command with the same or a lower indent, or the list size. */
+		int next;
+		/** Previous command with the same or a lower indent, or -1. */
+		int previous;
+	};
+
+	std::vector<Command> commands;
+	std::map<int, int> labels;
+};
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "null_ui.h"
+#include "audio.h"
+#include "bitmap.h"
+#include "pixel_format.h"
+#include "utils.h"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#ifndef NOMINMAX
+	#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+NullUi::NullUi(long width, long height) :
+	start_time(Utils::GetTimeNs()) {
+
+	current_display_mode.width = width;
+	current_display_mode.height = height;
+	current_display_mode.bpp = 32;
+
+	// Same layout as the SDL2 window texture
+	const DynamicFormat format = Utils::IsBigEndian() ?
+		DynamicFormat(32, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF, PF::NoAlpha) :
+		DynamicFormat(32, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000, PF::NoAlpha);
+	Bitmap::SetFormat(Bitmap::ChooseFormat(format));
+
+	main_surface = Bitmap::Create(width, height, Color(0, 0, 0, 255));
+
+	audio_.reset(new EmptyAudio());
+}
+
+NullUi::~NullUi() {
+}
+
+void NullUi::BeginDisplayModeChange() {
+}
+
+void NullUi::EndDisplayModeChange() {
+}
+
+void NullUi::Resize(long /* width */, long /* height */) {
+}
+
+void NullUi::ToggleFullscreen() {
+}
+
+void NullUi::ToggleZoom() {
+}
+
+void NullUi::UpdateDisplay() {
+}
+
+void NullUi::BeginScreenCapture() {
+	CleanDisplay();
+}
+
+BitmapRef NullUi::EndScreenCapture() {
+	return Bitmap::Create(*main_surface, main_surface->GetRect());
+}
+
+void NullUi::SetTitle(const std::string& /* title */) {
+}
+
+bool NullUi::ShowCursor(bool flag) {
+	bool temp_flag = cursor_visible;
+	cursor_visible = flag;
+	return temp_flag;
+}
+
+void NullUi::ProcessEvents() {
+}
+
+bool NullUi::IsFullscreen() {
+	return false;
+}
+
+uint32_t NullUi::GetTicks() const {
+	return (uint32_t)((Utils::GetTimeNs() - start_time) / 1000000);
+}
+
+void NullUi::Sleep(uint32_t time_milli) {
+#ifdef _WIN32
+	::Sleep(time_milli);
+#else
+	struct timespec ts;
+	ts.tv_sec = time_milli / 1000;
+	ts.tv_nsec = (time_milli % 1000) * 1000000L;
+	nanosleep(&ts, NULL);
+#endif
+}
+
+AudioInterface& NullUi::GetAudio() {
+	return *audio_;
+}
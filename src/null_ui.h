@@ -0,0 +1,84 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _NULL_UI_H_
+#define _NULL_UI_H_
+
+// Headers
+#include "baseui.h"
+#include "system.h"
+
+#include <boost/scoped_ptr.hpp>
+
+struct AudioInterface;
+
+/**
+ * NullUi class.
+ * Headless UI without window, input and audio. Everything is drawn to the
+ * main surface only, which makes the Player usable on machines without a
+ * display server, e.g. for automated tests.
+ */
+class NullUi : public BaseUi {
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param width display client width.
+	 * @param height display client height.
+	 */
+	NullUi(long width, long height);
+
+	/**
+	 * Destructor.
+	 */
+	~NullUi();
+
+	/**
+	 * Inherited from BaseUi.
+	 */
+	/** @{ */
+
+	void BeginDisplayModeChange();
+	void EndDisplayModeChange();
+	void Resize(long width, long height);
+	void ToggleFullscreen();
+	void ToggleZoom();
+	void UpdateDisplay();
+	void BeginScreenCapture();
+	BitmapRef EndScreenCapture();
+	void SetTitle(const std::string &title);
+	bool ShowCursor(bool flag);
+
+	void ProcessEvents();
+
+	bool IsFullscreen();
+
+	uint32_t GetTicks() const;
+	void Sleep(uint32_t time_milli);
+
+	AudioInterface& GetAudio();
+
+	/** @} */
+
+private:
+	/** Time of creation, GetTicks counts from here. */
+	uint64_t start_time;
+
+	boost::scoped_ptr<AudioInterface> audio_;
+};
+
+#endif
@@ -33,6 +33,8 @@
 #include "graphics.h"
 #include "inireader.h"
 #include "input.h"
+#include "input_latency.h"
+#include "interpreter_profiler.h"
 #include "ldb_reader.h"
 #include "lmt_reader.h"
 #include "lsd_reader.h"
@@ -46,6 +48,7 @@
 #include "scene_map.h"
 #include "scene_title.h"
 #include "system.h"
+#include "trace.h"
 #include "utils.h"
 
 #include <algorithm>
@@ -73,6 +76,9 @@ namespace Player {
 	bool debug_flag;
 	bool hide_title_flag;
 	bool window_flag;
+	bool headless_flag;
+	int turbo_frames;
+	int turbo_render_interval;
 	bool battle_test_flag;
 	int battle_test_troop_id;
 	bool new_game_flag;
@@ -83,13 +89,24 @@ namespace Player {
 	int start_map_id;
 	bool no_rtp_flag;
 	bool no_audio_flag;
+	bool sleep_events_flag;
 	std::string encoding;
 	std::string escape_symbol;
 	int engine;
 	std::string game_title;
-	double start_time;
-	double next_frame;
+	/** Deadlines of the frame pacer in Utils::GetTimeNs time. */
+	uint64_t start_time;
+	uint64_t next_frame;
+	/** End of the previous frame, for the frame interval statistic. */
+	uint64_t last_frame_time;
+	/** Renders skipped in a row to catch up with the deadline. */
+	int skipped_frames;
 	int frames;
+	uint64_t run_start_time;
+	/** Seed of the random number generator, stored in input logs. */
+	unsigned rng_seed;
+	std::string record_input_file;
+	std::string replay_input_file;
 #ifdef EMSCRIPTEN
 	std::string emscripten_game_name;
 #endif
@@ -130,10 +147,22 @@ void Player::Init(int argc, char *argv[]) {
 	);
 #endif
 
-	srand(time(NULL));
+	rng_seed = (unsigned)time(NULL);
 
 	ParseCommandLine(argc, argv);
 
+	if (!replay_input_file.empty()) {
+		// Replays must draw the same random numbers as the recording
+		Input::StartReplay(replay_input_file, rng_seed);
+	} else if (!record_input_file.empty()) {
+		Input::StartRecording(record_input_file, rng_seed);
+	}
+	if (!replay_input_file.empty() || !record_input_file.empty()) {
+		// Background reads finish on timing dependent frames
+		AsyncHandler::SetWorkerThreads(0);
+	}
+	srand(rng_seed);
+
 	if (Main_Data::project_path.empty()) {
 		// Not overwritten by --project-path
 		Main_Data::Init();
@@ -149,21 +178,15 @@ void Player::Init(int argc, char *argv[]) {
 			 SCREEN_TARGET_HEIGHT,
 			 game_title,
 			 !window_flag,
-			 RUN_ZOOM);
+			 RUN_ZOOM,
+			 headless_flag);
 	}
 
 	init = true;
 }
 
 void Player::Run() {
-	Scene::Push(EASYRPG_MAKE_SHARED<Scene>());
-
-	Scene::Push(EASYRPG_SHARED_PTR<Scene>(static_cast<Scene*>(new Scene_Logo())));
-
-	reset_flag = false;
-
-	// Reset frames before starting
-	FrameReset();
+	Start();
 
 	// Main loop
 #ifdef EMSCRIPTEN
@@ -174,6 +197,18 @@ void Player::Run() {
 #endif
 }
 
+void Player::Start() {
+	Scene::Push(EASYRPG_MAKE_SHARED<Scene>());
+
+	Scene::Push(EASYRPG_SHARED_PTR<Scene>(static_cast<Scene*>(new Scene_Logo())));
+
+	reset_flag = false;
+
+	// Reset frames before starting
+	FrameReset();
+	run_start_time = Utils::GetTimeNs();
+}
+
 void Player::MainLoop() {
 	Scene::instance->MainFunction();
 	for (size_t i = 0; i < Scene::old_instances.size(); ++i) {
@@ -196,10 +231,33 @@ void Player::Resume() {
 	FrameReset();
 }
 
+/** Sleep is only accurate to a few ms, the rest of a wait is spinning. */
+static const uint64_t spin_time = 2000000;
+
+/** Renders skipped in a row before one is forced. */
+static const int max_skipped_frames = 5;
+
+/** Frames behind after which the pacer gives up catching up. */
+static const int max_lag_frames = 10;
+
+static void WaitUntil(uint64_t deadline) {
+	for (;;) {
+		uint64_t now = Utils::GetTimeNs();
+		if (now >= deadline) {
+			break;
+		}
+		if (deadline - now > spin_time) {
+			DisplayUi->Sleep((uint32_t)((deadline - now - spin_time) / 1000000));
+		}
+	}
+}
+
 void Player::Update(bool update_scene) {
-	// available ms per frame, game logic expects 60 fps
-	static const double framerate_interval = 1000.0 / Graphics::GetDefaultFps();
-	next_frame = start_time + framerate_interval;
+	// available ns per frame, game logic expects 60 fps
+	static const uint64_t framerate_interval = 1000000000 / Graphics::GetDefaultFps();
+	// turbo mode shares the time of a drawn frame between its logic frames
+	uint64_t const frame_interval = turbo_frames > 1 ? framerate_interval / turbo_frames : framerate_interval;
+	next_frame = start_time + frame_interval;
 
 #ifdef EMSCRIPTEN
 	// Ticks in emscripten are unreliable due to how the main loop works:
@@ -207,18 +265,41 @@ void Player::Update(bool update_scene) {
 	// 1000s of times.
 	Graphics::Update(true);
 #else
-	// Time left before next frame? Let's render the current frame.
-	double cur_time = (double)DisplayUi->GetTicks();
-	if (cur_time < next_frame) {
-		Graphics::Update(true);
+	// Turbo mode draws every Kth frame, K defaults to the logic frames per paced frame
+	int const render_interval = turbo_render_interval > 0 ? turbo_render_interval : turbo_frames;
+	bool const render_frame = turbo_frames == 0 || frames % render_interval == 0;
+
+	if (turbo_frames > 0 && frames % turbo_frames != 0) {
+		// Logic only frame, waiting is done by the next paced frame
+		Graphics::Update(render_frame);
+	} else if (turbo_frames > 0 && headless_flag) {
+		// Nothing to present, run as fast as possible
+		Graphics::Update(render_frame);
+	} else {
+		// Time left before next frame? Let's render the current frame.
+		// When behind, rendering is skipped to catch up, but not too often in a row.
+		bool render = false;
+		if (render_frame) {
+			render = Utils::GetTimeNs() < next_frame || skipped_frames >= max_skipped_frames;
+			skipped_frames = render ? 0 : skipped_frames + 1;
+		}
+		Graphics::Update(render);
 
-		cur_time = (double)DisplayUi->GetTicks();
 		// Still time after graphic update? Yield until it's time for next one.
-		if (cur_time < next_frame) {
-			DisplayUi->Sleep((uint32_t)(next_frame - cur_time));
+		uint64_t const sleep_start = Graphics::BeginPhase();
+		WaitUntil(next_frame);
+		Graphics::EndPhase(Graphics::PhaseSleep, sleep_start);
+
+		// Late by more than the spin time means the frame work took too long
+		uint64_t const now = Utils::GetTimeNs();
+		bool const missed = now > next_frame + spin_time;
+		if (now > next_frame + max_lag_frames * frame_interval) {
+			// Too far behind, the game slows down instead of rushing to catch up
+			next_frame = now;
 		}
-	} else {
-		Graphics::Update(false);
+
+		Graphics::RecordFrameTime(now - last_frame_time, missed, !render);
+		last_frame_time = now;
 	}
 #endif
 
@@ -232,6 +313,12 @@ void Player::Update(bool update_scene) {
 	if (Input::IsTriggered(Input::SHOW_LOG)) {
 		Output::ToggleLog();
 	}
+	if (Input::IsTriggered(Input::TOGGLE_PROFILER)) {
+		Graphics::SetProfilerOnScreen(!Graphics::profiler_on_screen);
+	}
+	if (Input::IsTriggered(Input::DUMP_TRACE)) {
+		Trace::Dump();
+	}
 
 	DisplayUi->ProcessEvents();
 
@@ -244,11 +331,23 @@ void Player::Update(bool update_scene) {
 		}
 	}
 
+	// Switch and variable changes are tracked per frame
+	Game_Switches.GetChanges().ClearChanged();
+	Game_Variables.GetChanges().ClearChanged();
+
+	AsyncHandler::Update();
 	Audio().Update();
 	Input::Update();
 	if (update_scene) {
+		TRACE_SCOPE("scene", "Scene::Update");
+
+		uint64_t const logic_start = Graphics::BeginPhase();
 		Scene::instance->Update();
+		Graphics::EndPhase(Graphics::PhaseLogic, logic_start);
+
+		InputLatency::SceneUpdated();
 	}
+	Graphics::EndProfilerFrame();
 
 	start_time = next_frame;
 	++frames;
@@ -256,10 +355,12 @@ void Player::Update(bool update_scene) {
 
 void Player::FrameReset() {
 	// When update started
-	start_time = (double)DisplayUi->GetTicks();
+	start_time = Utils::GetTimeNs();
+	last_frame_time = start_time;
+	skipped_frames = 0;
 
-	// available ms per frame, game logic expects 60 fps
-	static const double framerate_interval = 1000.0 / Graphics::GetDefaultFps();
+	// available ns per frame, game logic expects 60 fps
+	static const uint64_t framerate_interval = 1000000000 / Graphics::GetDefaultFps();
 
 	// When next frame is expected
 	next_frame = start_time + framerate_interval;
@@ -271,6 +372,23 @@ int Player::GetFrames() {
 	return frames;
 }
 
+/** Writes the recorded switch and variable changes to the log, see --change-journal. */
+static void LogChangeJournals() {
+	typedef std::deque<ChangeJournal<bool>::Entry> switch_journal;
+	const switch_journal& switches = Game_Switches.GetChanges().GetJournal();
+	for (switch_journal::const_iterator it = switches.begin(); it != switches.end(); ++it) {
+		Output::Debug("Frame %d: Switch %04d %s -> %s", it->frame, it->id,
+			it->old_value ? "ON" : "OFF", it->new_value ? "ON" : "OFF");
+	}
+
+	typedef std::deque<ChangeJournal<int>::Entry> variable_journal;
+	const variable_journal& variables = Game_Variables.GetChanges().GetJournal();
+	for (variable_journal::const_iterator it = variables.begin(); it != variables.end(); ++it) {
+		Output::Debug("Frame %d: Variable %04d %d -> %d", it->frame, it->id,
+			it->old_value, it->new_value);
+	}
+}
+
 void Player::Exit() {
 #ifdef EMSCRIPTEN
 	emscripten_cancel_main_loop();
@@ -282,6 +400,18 @@ void Player::Exit() {
 	DisplayUi->UpdateDisplay();
 #endif
 
+	if (turbo_frames > 0) {
+		double seconds = (Utils::GetTimeNs() - run_start_time) / 1000000000.0;
+		Output::Debug("Turbo mode ran %d frames in %.2f s (%.1f frames per second)",
+			frames, seconds, seconds > 0 ? frames / seconds : 0.0);
+	}
+
+	LogChangeJournals();
+	InputLatency::Report();
+	Input::StopRecording();
+	AsyncHandler::Quit();
+	Trace::Quit();
+	InterpreterProfiler::Quit();
 	Main_Data::Cleanup();
 	Graphics::Quit();
 	FileFinder::Quit();
@@ -300,6 +430,9 @@ void Player::ParseCommandLine(int argc, char *argv[]) {
 #else
 	window_flag = false;
 #endif
+	headless_flag = false;
+	turbo_frames = 0;
+	turbo_render_interval = 0;
 	debug_flag = false;
 	hide_title_flag = false;
 	exit_flag = false;
@@ -313,6 +446,7 @@ void Player::ParseCommandLine(int argc, char *argv[]) {
 	start_map_id = -1;
 	no_rtp_flag = false;
 	no_audio_flag = false;
+	sleep_events_flag = false;
 
 	std::vector<std::string> args;
 
@@ -329,6 +463,9 @@ void Player::ParseCommandLine(int argc, char *argv[]) {
 		else if (*it == "testplay" || *it == "--test-play") {
 			debug_flag = true;
 		}
+		else if (*it == "--headless") {
+			headless_flag = true;
+		}
 		else if (*it == "hidetitle" || *it == "--hide-title") {
 			hide_title_flag = true;
 		}
@@ -352,6 +489,14 @@ void Player::ParseCommandLine(int argc, char *argv[]) {
 			battle_test_flag = true;
 			battle_test_troop_id = atoi((*it).c_str());
 		}
+		else if (*it == "--change-journal") {
+			++it;
+			if (it == args.end()) {
+				return;
+			}
+			Game_Switches.GetChanges().SetJournalSize(atoi((*it).c_str()));
+			Game_Variables.GetChanges().SetJournalSize(atoi((*it).c_str()));
+		}
 		else if (*it == "--project-path") {
 			++it;
 			if (it == args.end()) {
@@ -360,6 +505,32 @@ void Player::ParseCommandLine(int argc, char *argv[]) {
 			// case sensitive
 			Main_Data::project_path = argv[it - args.begin() + 1];
 		}
+		else if (*it == "--file-index") {
+			++it;
+			if (it == args.end()) {
+				return;
+			}
+			// case sensitive
+			FileFinder::SetIndexFile(argv[it - args.begin() + 1]);
+		}
+		else if (*it == "--io-threads") {
+			++it;
+			if (it == args.end()) {
+				return;
+			}
+			AsyncHandler::SetWorkerThreads(atoi((*it).c_str()));
+		}
+		else if (*it == "--event-profile") {
+			++it;
+			if (it == args.end()) {
+				return;
+			}
+			// case sensitive
+			InterpreterProfiler::SetOutputFile(argv[it - args.begin() + 1]);
+		}
+		else if (*it == "--measure-latency") {
+			InputLatency::SetEnabled(true);
+		}
 		else if (*it == "--new-game") {
 			new_game_flag = true;
 		}
@@ -387,7 +558,26 @@ void Player::ParseCommandLine(int argc, char *argv[]) {
 			if (it == args.end()) {
 				return;
 			}
-			srand(atoi((*it).c_str()));
+			rng_seed = (unsigned)atoi((*it).c_str());
+		}
+		else if (*it == "--record-input") {
+			++it;
+			if (it == args.end()) {
+				return;
+			}
+			// case sensitive
+			record_input_file = argv[it - args.begin() + 1];
+		}
+		else if (*it == "--replay-input") {
+			++it;
+			if (it == args.end()) {
+				return;
+			}
+			// case sensitive
+			replay_input_file = argv[it - args.begin() + 1];
+		}
+		else if (*it == "--sleep-events") {
+			sleep_events_flag = true;
 		}
 		else if (*it == "--start-map-id") {
 			++it;
@@ -439,6 +629,28 @@ void Player::ParseCommandLine(int argc, char *argv[]) {
 		else if (*it == "--disable-rtp") {
 			no_rtp_flag = true;
 		}
+		else if (*it == "--trace") {
+			++it;
+			if (it == args.end()) {
+				return;
+			}
+			// case sensitive
+			Trace::SetOutputFile(argv[it - args.begin() + 1]);
+		}
+		else if (*it == "--turbo") {
+			++it;
+			if (it == args.end()) {
+				return;
+			}
+			turbo_frames = std::max(1, atoi((*it).c_str()));
+		}
+		else if (*it == "--turbo-render") {
+			++it;
+			if (it == args.end()) {
+				return;
+			}
+			turbo_render_interval = std::max(1, atoi((*it).c_str()));
+		}
 		else if (*it == "--version" || *it == "-v") {
 			PrintVersion();
 			exit(0);
@@ -479,6 +691,11 @@ void Player::CreateGameObjects() {
 			std::string title = ini.Get("RPG_RT", "GameTitle", GAME_TITLE);
 			game_title = ReaderUtil::Recode(title, encoding);
 			no_rtp_flag = ini.Get("RPG_RT", "FullPackageFlag", "0") == "1"? true : no_rtp_flag;
+			// Games depending on exact off-screen event movement opt out
+			if (ini.Get("EasyRPG", "ExactOffscreenEvents", "0") == "1" && sleep_events_flag) {
+				Output::Debug("Event sleeping disabled by %s", INI_NAME);
+				sleep_events_flag = false;
+			}
 		}
 
 		if (Player::engine == EngineNone) {
@@ -665,6 +882,9 @@ void Player::PrintUsage() {
 	//                                                  "                                Line end marker -> "
 	std::cout << "      " << "--battle-test N      " << "Start a battle test with monster party N." << std::endl;
 
+	std::cout << "      " << "--change-journal N   " << "Keep the last N switch and variable changes and" << std::endl;
+	std::cout << "      " << "                     " << "write them to the log on exit." << std::endl;
+
 	std::cout << "      " << "--disable-audio      " << "Disable audio (in case you prefer your own music)." << std::endl;
 
 	std::cout << "      " << "--disable-rtp        " << "Disable support for the Runtime Package (RTP)." << std::endl;
@@ -678,21 +898,50 @@ void Player::PrintUsage() {
 	std::cout << "      " << "                     " << " rpg2k3  - RPG Maker 2003 engine" << std::endl;
 	std::cout << "      " << "                     " << " rpg2k3e - RPG Maker 2003 (English release) engine" << std::endl;
 
+	std::cout << "      " << "--event-profile FILE " << "Measure the time spent in each event and event" << std::endl;
+	std::cout << "      " << "                     " << "command and write it as CSV to FILE on exit." << std::endl;
+	std::cout << "      " << "                     " << "The TestPlay debug menu shows the slowest ones." << std::endl;
+
+	std::cout << "      " << "--file-index FILE    " << "Cache the directory listings of the game and RTP in" << std::endl;
+	std::cout << "      " << "                     " << "FILE to speed up the next start." << std::endl;
+
 	std::cout << "      " << "--fullscreen         " << "Start in fullscreen mode." << std::endl;
 
+	std::cout << "      " << "--headless           " << "Run without window, input and audio. The game is" << std::endl;
+	std::cout << "      " << "                     " << "only drawn to memory, for automated tests." << std::endl;
+
 	std::cout << "      " << "--hide-title         " << "Hide the title background image and center the" << std::endl;
 	std::cout << "      " << "                     " << "command menu." << std::endl;
 
+	std::cout << "      " << "--io-threads N       " << "Read images on N background threads while the" << std::endl;
+	std::cout << "      " << "                     " << "game keeps running. Ignored while recording or" << std::endl;
+	std::cout << "      " << "                     " << "replaying input." << std::endl;
+
 	std::cout << "      " << "--load-game-id N     " << "Skip the title scene and load SaveN.lsd" << std::endl;
 	std::cout << "      " << "                     " << "(N is padded to two digits)." << std::endl;
 
+	std::cout << "      " << "--measure-latency    " << "Measure the time from a key press until the screen" << std::endl;
+	std::cout << "      " << "                     " << "changes and log min, median and p99 on exit." << std::endl;
+
 	std::cout << "      " << "--new-game           " << "Skip the title scene and start a new game directly." << std::endl;
 
 	std::cout << "      " << "--project-path PATH  " << "Instead of using the working directory the game in" << std::endl;
 	std::cout << "      " << "                     " << "PATH is used." << std::endl;
 
+	std::cout << "      " << "--record-input FILE  " << "Write the pressed buttons of every frame and the" << std::endl;
+	std::cout << "      " << "                     " << "random seed to FILE." << std::endl;
+
+	std::cout << "      " << "--replay-input FILE  " << "Play the input recorded with --record-input again" << std::endl;
+	std::cout << "      " << "                     " << "instead of reading the keyboard and exit at its end." << std::endl;
+
 	std::cout << "      " << "--seed N            " << "Seeds the random number generator with N." << std::endl;
 
+	std::cout << "      " << "--sleep-events       " << "Idle events far outside of the screen pause until" << std::endl;
+	std::cout << "      " << "                     " << "they get close again. Faster on big maps but events" << std::endl;
+	std::cout << "      " << "                     " << "with random movement stop moving meanwhile." << std::endl;
+	std::cout << "      " << "                     " << "Games set ExactOffscreenEvents=1 in the [EasyRPG]" << std::endl;
+	std::cout << "      " << "                     " << "section of RPG_RT.ini to opt out." << std::endl;
+
 	std::cout << "      " << "--start-map-id N     " << "Overwrite the map used for new games and use." << std::endl;
 	std::cout << "      " << "                     " << "MapN.lmu instead (N is padded to four digits)." << std::endl;
 	std::cout << "      " << "                     " << "Incompatible with --load-game-id." << std::endl;
@@ -707,6 +956,16 @@ void Player::PrintUsage() {
 
 	std::cout << "      " << "--test-play          " << "Enable TestPlay mode." << std::endl;
 
+	std::cout << "      " << "--trace FILE         " << "Record the time of file access, image decoding," << std::endl;
+	std::cout << "      " << "                     " << "interpreters and drawing. Written to FILE in the" << std::endl;
+	std::cout << "      " << "                     " << "Chrome trace format on exit and when F7 is pressed." << std::endl;
+
+	std::cout << "      " << "--turbo N            " << "Run N logic frames per drawn frame to fast forward" << std::endl;
+	std::cout << "      " << "                     " << "the game. With --headless there is no frame limit." << std::endl;
+
+	std::cout << "      " << "--turbo-render K     " << "Draw only every Kth frame in turbo mode instead of" << std::endl;
+	std::cout << "      " << "                     " << "every Nth." << std::endl;
+
 	std::cout << "      " << "--window             " << "Start in window mode." << std::endl;
 
 	std::cout << "  -v, " << "--version            " << "Display program version and exit." << std::endl;
@@ -47,6 +47,12 @@ namespace Player {
 	 */
 	void Run();
 
+	/**
+	 * Pushes the first scenes and starts counting frames.
+	 * Called by Run, programs calling MainLoop themselves call it instead.
+	 */
+	void Start();
+
 	/**
 	 * Runs the game loop.
 	 */
@@ -163,6 +169,21 @@ namespace Player {
 	/** Window flag, if true will run in window mode instead of full screen. */
 	extern bool window_flag;
 
+	/** Headless flag, if true will run without display, input and audio. */
+	extern bool headless_flag;
+
+	/**
+	 * Turbo mode, runs this many logic frames per drawn frame.
+	 * Without frame limit when headless, 0 disables turbo mode.
+	 */
+	extern int turbo_frames;
+
+	/**
+	 * Turbo mode draws only every this many frames.
+	 * 0 draws once per turbo_frames logic frames.
+	 */
+	extern int turbo_render_interval;
+
 	/** Battle Test flag, if true will run battle test. */
 	extern bool battle_test_flag;
 
@@ -193,6 +214,12 @@ namespace Player {
 	/** Mutes audio playback */
 	extern bool no_audio_flag;
 
+	/**
+	 * Lets idle events far outside of the screen skip their update.
+	 * Cleared when RPG_RT.ini sets ExactOffscreenEvents in [EasyRPG].
+	 */
+	extern bool sleep_events_flag;
+
 	/** Encoding used */
 	extern std::string encoding;
 
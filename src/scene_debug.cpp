@@ -26,11 +26,14 @@
 #include "game_switches.h"
 #include "game_map.h"
 #include "game_system.h"
+#include "interpreter_profiler.h"
 #include "scene_debug.h"
 #include "player.h"
 #include "window_command.h"
 #include "window_varlist.h"
 #include "window_numberinput.h"
+#include "window_eventprofile.h"
+#include "window_bitmapmemory.h"
 #include "bitmap.h"
 
 Scene_Debug::Scene_Debug() {
@@ -44,6 +47,8 @@ void Scene_Debug::Start() {
 	CreateRangeWindow();
 	CreateVarListWindow();
 	CreateNumberInputWindow();
+	CreateProfileWindow();
+	CreateMemoryWindow();
 
 	range_window->SetActive(true);
 	var_window->SetActive(false);
@@ -56,6 +61,7 @@ void Scene_Debug::Update() {
 		range_index = range_window->GetIndex();
 		var_window->UpdateList(range_page * 100 + range_index * 10 + 1);
 		var_window->Refresh();
+		UpdateProfileWindow();
 	}
 	var_window->Update();
 
@@ -77,12 +83,18 @@ void Scene_Debug::Update() {
 		}
 	} else if (Input::IsTriggered(Input::DECISION)) {
 		var_window->Refresh();
-		if (range_window->GetActive()) {
+		if (current_var_type == TypeProfile) {
+			// Takes a new snapshot, the profile keeps recording in the background
+			profile_window->Refresh();
+		} else if (current_var_type == TypeMemory) {
+			memory_window->Refresh();
+			Bitmap::DumpMemoryStats();
+		} else if (range_window->GetActive()) {
 			range_window->SetActive(false);
 			var_window->SetActive(true);
 		} else if (var_window->GetActive()) {
 			if (current_var_type == TypeSwitch && Game_Switches.isValidSwitch(GetIndex()))
-				Game_Switches[GetIndex()] = !Game_Switches[GetIndex()];
+				Game_Switches.Set(GetIndex(), !Game_Switches[GetIndex()]);
 			else if (current_var_type == TypeInt && Game_Variables.isValidVar(GetIndex())) {
 				var_window->SetActive(false);
 				numberinput_window->SetNumber(Game_Variables[GetIndex()]);
@@ -91,30 +103,46 @@ void Scene_Debug::Update() {
 			}
 			var_window->Refresh();
 		} else if (numberinput_window->GetActive()) {
-			Game_Variables[GetIndex()] = numberinput_window->GetNumber();
+			Game_Variables.Set(GetIndex(), numberinput_window->GetNumber());
 			numberinput_window->SetActive(false);
 			numberinput_window->SetVisible(false);
 			var_window->SetActive(true);
 			var_window->Refresh();
 		}
-		Game_Map::SetNeedRefresh(true);
 	} else if (range_window->GetActive() &&  Input::IsTriggered(Input::RIGHT)) {
 		range_page++;
-		if (current_var_type == TypeSwitch && !Game_Switches.isValidSwitch(range_page*100+1)) {
+		if (current_var_type == TypeProfile) {
+			range_page = 0;
+			current_var_type = TypeMemory;
+		} else if (current_var_type == TypeMemory) {
+			range_page = 0;
+			current_var_type = TypeSwitch;
+			var_window->SetShowSwitch(true);
+		} else if (current_var_type == TypeSwitch && !Game_Switches.isValidSwitch(range_page*100+1)) {
 			range_page = 0;
 			current_var_type = TypeInt;
 			var_window->SetShowSwitch(false);
 		} else if (current_var_type == TypeInt && !Game_Variables.isValidVar(range_page*100+1)) {
 			range_page = 0;
-			current_var_type = TypeSwitch;
-			var_window->SetShowSwitch(true);
+			if (InterpreterProfiler::IsEnabled()) {
+				current_var_type = TypeProfile;
+			} else {
+				current_var_type = TypeMemory;
+			}
 		}
 		var_window->UpdateList(range_page * 100 + range_index * 10 + 1);
 		UpdateRangeListWindow();
 		var_window->Refresh();
+		UpdateProfileWindow();
 	} else if (range_window->GetActive() && Input::IsTriggered(Input::LEFT)) {
 		range_page--;
 		if (current_var_type == TypeSwitch && range_page < 0) {
+			range_page = 0;
+			current_var_type = TypeMemory;
+		} else if (current_var_type == TypeMemory && InterpreterProfiler::IsEnabled()) {
+			range_page = 0;
+			current_var_type = TypeProfile;
+		} else if (current_var_type == TypeMemory || current_var_type == TypeProfile) {
 			range_page = 0;
 			for (;;)
 				if (Game_Variables.isValidVar(range_page*100 + 101))
@@ -136,6 +164,7 @@ void Scene_Debug::Update() {
 		var_window->UpdateList(range_page * 100 + range_index * 10 + 1);
 		UpdateRangeListWindow();
 		var_window->Refresh();
+		UpdateProfileWindow();
 	}
 }
 
@@ -152,6 +181,19 @@ void Scene_Debug::CreateRangeWindow() {
 }
 	
 void Scene_Debug::UpdateRangeListWindow() {
+	if (current_var_type == TypeProfile) {
+		for (int i = 0; i < 10; i++) {
+			range_window->SetItemText(i, i == 0 ? "Events" : i == 1 ? "Commands" : "");
+		}
+		return;
+	}
+	if (current_var_type == TypeMemory) {
+		for (int i = 0; i < 10; i++) {
+			range_window->SetItemText(i, i == 0 ? "Bitmaps" : "");
+		}
+		return;
+	}
+
 	std::stringstream ss;
 	for (int i = 0; i < 10; i++){
 		ss.str("");
@@ -186,6 +228,32 @@ void Scene_Debug::CreateNumberInputWindow() {
 	numberinput_window->SetShowOperator(true);
 }
 
+void Scene_Debug::CreateProfileWindow() {
+	profile_window.reset(new Window_EventProfile(range_window->GetWidth(), range_window->GetY(),
+		var_window->GetWidth(), var_window->GetHeight()));
+	profile_window->SetVisible(false);
+}
+
+void Scene_Debug::CreateMemoryWindow() {
+	memory_window.reset(new Window_BitmapMemory(range_window->GetWidth(), range_window->GetY(),
+		var_window->GetWidth(), var_window->GetHeight()));
+	memory_window->SetVisible(false);
+}
+
+void Scene_Debug::UpdateProfileWindow() {
+	bool show_profile = current_var_type == TypeProfile;
+	bool show_memory = current_var_type == TypeMemory;
+	var_window->SetVisible(!show_profile && !show_memory);
+	profile_window->SetVisible(show_profile);
+	memory_window->SetVisible(show_memory);
+	if (show_profile) {
+		profile_window->SetShowCommands(range_index == 1);
+	}
+	if (show_memory) {
+		memory_window->Refresh();
+	}
+}
+
 int Scene_Debug::GetIndex() {
 	return (range_page * 100 + range_index * 10 + var_window->GetIndex() + 1);
 }
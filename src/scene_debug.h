@@ -26,6 +26,8 @@
 class Window_Command;
 class Window_VarList;
 class Window_NumberInput;
+class Window_EventProfile;
+class Window_BitmapMemory;
 
 /**
  * Scene Equip class.
@@ -64,7 +66,9 @@ public:
 
 	enum VarType {
 		TypeInt,
-		TypeSwitch
+		TypeSwitch,
+		TypeProfile,
+		TypeMemory
 	};
 
 private:
@@ -84,12 +88,25 @@ private:
 	/** Creates number input window. */
 	void CreateNumberInputWindow();
 
+	/** Creates interpreter profile window. */
+	void CreateProfileWindow();
+
+	/** Creates bitmap memory window. */
+	void CreateMemoryWindow();
+
+	/** Shows the profile or memory window instead of the var list on their pages. */
+	void UpdateProfileWindow();
+
 	/** Displays a range selection for current var type. */
 	boost::scoped_ptr<Window_Command> range_window;
 	/** Displays the vars inside the current range. */
 	boost::scoped_ptr<Window_VarList> var_window;
 	/** Number Editor. */
 	boost::scoped_ptr<Window_NumberInput> numberinput_window;
+	/** Displays the slowest events or commands. */
+	boost::scoped_ptr<Window_EventProfile> profile_window;
+	/** Displays the bitmap memory of each category. */
+	boost::scoped_ptr<Window_BitmapMemory> memory_window;
 };
 
 #endif
@@ -107,7 +107,9 @@ void Scene_Map::Update() {
 		FinishTeleportPlayer();
 	}
 
+	uint64_t const interpreter_start = Graphics::BeginPhase();
 	Game_Map::GetInterpreter().Update();
+	Graphics::EndPhase(Graphics::PhaseInterpreter, interpreter_start);
 
 	Main_Data::game_party->UpdateTimers();
 
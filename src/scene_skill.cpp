@@ -64,7 +64,6 @@ void Scene_Skill::Update() {
 			if (Data::skills[skill_id - 1].type == RPG::Skill::Type_switch) {
 				actor->UseSkill(skill_id);
 				Scene::PopUntil(Scene::Map);
-				Game_Map::SetNeedRefresh(true);
 			} else if (Data::skills[skill_id - 1].type == RPG::Skill::Type_normal) {
 				Scene::Push(EASYRPG_MAKE_SHARED<Scene_ActorTarget>(skill_id, actor_index, skill_window->GetIndex()));
 				skill_index = skill_window->GetIndex();
@@ -38,6 +38,7 @@
 #endif
 #include "color.h"
 #include "graphics.h"
+#include "input_latency.h"
 #include "keys.h"
 #include "output.h"
 #include "player.h"
@@ -519,6 +520,19 @@ void SdlUi::ToggleZoom() {
 	}
 }
 
+/**
+ * Time the event waited in the SDL queue, SDL 1 events carry no timestamp.
+ */
+static uint64_t EventAge(const SDL_Event& evnt) {
+#if SDL_MAJOR_VERSION==1
+	(void)evnt;
+	return 0;
+#else
+	uint32_t const now = SDL_GetTicks();
+	return now > evnt.common.timestamp ? (uint64_t)(now - evnt.common.timestamp) * 1000000 : 0;
+#endif
+}
+
 void SdlUi::ProcessEvents() {
 	SDL_Event evnt;
 
@@ -755,6 +769,7 @@ void SdlUi::ProcessKeyDownEvent(SDL_Event &evnt) {
 		keys[SdlKey2InputKey(evnt.key.keysym.scancode)] = true;
 
 #endif
+		InputLatency::KeyEvent(EventAge(evnt));
 		return;
 	}
 #endif
@@ -797,6 +812,9 @@ void SdlUi::ProcessMouseButtonEvent(SDL_Event& /* evnt */) {
 void SdlUi::ProcessJoystickButtonEvent(SDL_Event &evnt) {
 #if defined(USE_JOYSTICK) && defined(SUPPORT_JOYSTICK)
 	keys[SdlJKey2InputKey(evnt.jbutton.button)] = evnt.jbutton.state == SDL_PRESSED;
+	if (evnt.jbutton.state == SDL_PRESSED) {
+		InputLatency::KeyEvent(EventAge(evnt));
+	}
 #endif
 }
 
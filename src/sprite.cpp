@@ -152,8 +152,10 @@ BitmapRef Sprite::Refresh(Rect& rect) {
 		bitmap_effects.reset();
 		}
 
-		if (!bitmap_effects)
+		if (!bitmap_effects) {
+			Bitmap::MemoryScope memory_scope(Bitmap::MemorySprite);
 			bitmap_effects = Bitmap::Create(bitmap->GetWidth(), bitmap->GetHeight(), true);
+		}
 
 		bitmap_effects->Clear();
 		if (no_tone && no_flash)
@@ -0,0 +1,215 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "trace.h"
+#include "filefinder.h"
+#include "output.h"
+
+#ifndef EMSCRIPTEN
+#include <SDL.h>
+#include <SDL_thread.h>
+#endif
+
+#ifdef _MSC_VER
+#define TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#define TRACE_THREAD_LOCAL __thread
+#endif
+
+bool Trace::enabled = false;
+
+namespace {
+	/** Scopes kept per thread, older ones are overwritten. */
+	const size_t buffer_size = 64 * 1024;
+
+	struct Event {
+		const char* category;
+		const char* name;
+		uint64_t start_ns;
+		uint64_t end_ns;
+	};
+
+	struct ThreadBuffer {
+		int tid;
+		std::vector<Event> events;
+		/** Next slot in events once it reached buffer_size */
+		size_t pos;
+#ifndef EMSCRIPTEN
+		/** Guards events against Dump, only contended while dumping */
+		SDL_mutex* mutex;
+#endif
+	};
+
+	std::string output_file;
+
+	/** Buffers of all threads that recorded something */
+	std::vector<ThreadBuffer*> buffers;
+
+	TRACE_THREAD_LOCAL ThreadBuffer* thread_buffer = NULL;
+
+#ifndef EMSCRIPTEN
+	/** Guards buffers */
+	SDL_mutex* buffers_mutex = NULL;
+#endif
+
+	void Lock(ThreadBuffer& buffer) {
+#ifndef EMSCRIPTEN
+		SDL_LockMutex(buffer.mutex);
+#endif
+	}
+
+	void Unlock(ThreadBuffer& buffer) {
+#ifndef EMSCRIPTEN
+		SDL_UnlockMutex(buffer.mutex);
+#endif
+	}
+
+	ThreadBuffer* CreateThreadBuffer() {
+		ThreadBuffer* buffer = new ThreadBuffer();
+		buffer->events.reserve(buffer_size);
+		buffer->pos = 0;
+#ifndef EMSCRIPTEN
+		buffer->mutex = SDL_CreateMutex();
+		SDL_LockMutex(buffers_mutex);
+#endif
+		buffer->tid = buffers.size() + 1;
+		buffers.push_back(buffer);
+#ifndef EMSCRIPTEN
+		SDL_UnlockMutex(buffers_mutex);
+#endif
+		return buffer;
+	}
+}
+
+void Trace::SetEnabled(bool enable) {
+#ifndef EMSCRIPTEN
+	// Created before any thread can record
+	if (enable && !buffers_mutex) {
+		buffers_mutex = SDL_CreateMutex();
+	}
+#endif
+	enabled = enable;
+}
+
+void Trace::SetOutputFile(const std::string& file) {
+	output_file = file;
+	SetEnabled(true);
+}
+
+void Trace::Record(const char* category, const char* name, uint64_t start_ns) {
+	// Scopes ending after tracing was switched off are dropped
+	if (!enabled) {
+		return;
+	}
+
+	if (!thread_buffer) {
+		thread_buffer = CreateThreadBuffer();
+	}
+
+	Event event;
+	event.category = category;
+	event.name = name;
+	event.start_ns = start_ns;
+	event.end_ns = Utils::GetTimeNs();
+
+	ThreadBuffer& buffer = *thread_buffer;
+	Lock(buffer);
+	if (buffer.events.size() < buffer_size) {
+		buffer.events.push_back(event);
+	} else {
+		buffer.events[buffer.pos] = event;
+		buffer.pos = (buffer.pos + 1) % buffer_size;
+	}
+	Unlock(buffer);
+}
+
+bool Trace::Dump() {
+	if (output_file.empty()) {
+		return false;
+	}
+
+	EASYRPG_SHARED_PTR<std::fstream> out = FileFinder::openUTF8(output_file, std::ios_base::out | std::ios_base::trunc);
+	if (!out) {
+		Output::Warning("Cannot write trace %s", output_file.c_str());
+		return false;
+	}
+
+#ifndef EMSCRIPTEN
+	SDL_LockMutex(buffers_mutex);
+#endif
+	// Timestamps are microseconds, relative to the earliest start.
+	// Events are stored when they end, so a scope enclosing others is
+	// stored after them and every event has to be checked.
+	// The buffers stay locked until they are written.
+	uint64_t origin = ~(uint64_t)0;
+	for (size_t i = 0; i < buffers.size(); ++i) {
+		Lock(*buffers[i]);
+		const std::vector<Event>& events = buffers[i]->events;
+		for (size_t e = 0; e < events.size(); ++e) {
+			origin = std::min(origin, events[e].start_ns);
+		}
+	}
+
+	int count = 0;
+	*out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (size_t i = 0; i < buffers.size(); ++i) {
+		const ThreadBuffer& buffer = *buffers[i];
+		for (size_t e = 0; e < buffer.events.size(); ++e) {
+			// Oldest first
+			const Event& event = buffer.events[(buffer.pos + e) % buffer.events.size()];
+
+			char line[256];
+			sprintf(line, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+				count > 0 ? "," : "", event.name, event.category,
+				(int64_t)(event.start_ns - origin) / 1000.0, (int64_t)(event.end_ns - event.start_ns) / 1000.0, buffer.tid);
+			*out << line;
+			++count;
+		}
+		Unlock(*buffers[i]);
+	}
+	*out << "\n]}\n";
+#ifndef EMSCRIPTEN
+	SDL_UnlockMutex(buffers_mutex);
+#endif
+
+	Output::Debug("Wrote %d trace events to %s", count, output_file.c_str());
+	return true;
+}
+
+void Trace::Quit() {
+	enabled = false;
+	Dump();
+
+	for (size_t i = 0; i < buffers.size(); ++i) {
+#ifndef EMSCRIPTEN
+		SDL_DestroyMutex(buffers[i]->mutex);
+#endif
+		delete buffers[i];
+	}
+	buffers.clear();
+	thread_buffer = NULL;
+
+#ifndef EMSCRIPTEN
+	SDL_DestroyMutex(buffers_mutex);
+	buffers_mutex = NULL;
+#endif
+}
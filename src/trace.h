@@ -0,0 +1,103 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+// Headers
+#include <string>
+#include "system.h"
+#include "utils.h"
+
+/**
+ * Trace records timed scopes of the engine subsystems into a ring buffer
+ * per thread and writes them in the Chrome trace event format, viewable
+ * in chrome://tracing and other trace viewers.
+ *
+ * Scopes are placed with TRACE_SCOPE. Building with NO_TRACE removes them,
+ * otherwise a disabled trace costs one flag check per scope.
+ */
+namespace Trace {
+	/** Whether scopes are recorded, use SetEnabled to change. */
+	extern bool enabled;
+
+	/**
+	 * Enables or disables recording.
+	 *
+	 * @param enabled whether scopes are recorded.
+	 */
+	void SetEnabled(bool enabled);
+
+	/**
+	 * Enables recording and sets the file written by Dump and Quit.
+	 *
+	 * @param file trace file name.
+	 */
+	void SetOutputFile(const std::string& file);
+
+	/**
+	 * Adds a finished scope to the buffer of the calling thread.
+	 *
+	 * @param category subsystem, must be a string literal.
+	 * @param name scope name, must be a string literal.
+	 * @param start_ns start time in Utils::GetTimeNs time.
+	 */
+	void Record(const char* category, const char* name, uint64_t start_ns);
+
+	/**
+	 * Writes the buffered scopes of all threads to the output file.
+	 *
+	 * @return whether the file was written.
+	 */
+	bool Dump();
+
+	/**
+	 * Dumps the trace when an output file was set and frees the buffers.
+	 * Other threads must not record anymore.
+	 */
+	void Quit();
+
+	/** Records the lifetime of the object, see TRACE_SCOPE. */
+	class Scope {
+	public:
+		Scope(const char* category, const char* name) :
+			category(category), name(name), start(enabled ? Utils::GetTimeNs() : 0) {}
+
+		~Scope() {
+			if (start != 0) {
+				Record(category, name, start);
+			}
+		}
+
+	private:
+		const char* category;
+		const char* name;
+		uint64_t start;
+	};
+}
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+#ifdef NO_TRACE
+#define TRACE_SCOPE(category, name)
+#else
+/** Records the rest of the enclosing block as a trace scope. */
+#define TRACE_SCOPE(category, name) Trace::Scope TRACE_CONCAT(trace_scope_, __LINE__)(category, name)
+#endif
+
+#endif
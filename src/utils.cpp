@@ -22,6 +22,15 @@
 #include <boost/regex/pending/unicode_iterator.hpp>
 #include <boost/static_assert.hpp>
 
+#if defined(_WIN32)
+#  include <windows.h>
+#elif defined(__APPLE__)
+#  include <mach/mach_time.h>
+#else
+#  include <time.h>
+#  include <sys/time.h>
+#endif
+
 using boost::u8_to_u32_iterator;
 using boost::u16_to_u32_iterator;
 using boost::u32_to_u16_iterator;
@@ -108,3 +117,32 @@ bool Utils::IsBigEndian() {
 
     return(d.c[0] == 1);
 }
+
+uint64_t Utils::GetTimeNs() {
+#if defined(_WIN32)
+	static LARGE_INTEGER freq;
+	if (freq.QuadPart == 0) {
+		QueryPerformanceFrequency(&freq);
+	}
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	// Split to avoid an overflow of the multiplication
+	uint64_t const sec = now.QuadPart / freq.QuadPart;
+	uint64_t const rem = now.QuadPart % freq.QuadPart;
+	return sec * 1000000000u + rem * 1000000000u / freq.QuadPart;
+#elif defined(__APPLE__)
+	static mach_timebase_info_data_t info;
+	if (info.denom == 0) {
+		mach_timebase_info(&info);
+	}
+	return mach_absolute_time() * info.numer / info.denom;
+#elif defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (uint64_t)tv.tv_sec * 1000000000u + (uint64_t)tv.tv_usec * 1000u;
+#endif
+}
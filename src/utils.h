@@ -98,6 +98,14 @@ namespace Utils {
 
 	bool IsBigEndian();
 
+	/**
+	 * Reads a monotonic clock with high resolution.
+	 * Unlike BaseUi::GetTicks this is usable before the UI is created.
+	 *
+	 * @return time in nanoseconds since an unspecified starting point.
+	 */
+	uint64_t GetTimeNs();
+
 } // namespace Utils
 
 #endif
@@ -197,6 +197,7 @@ void Window::Draw() {
 void Window::RefreshBackground() {
 	background_needs_refresh = false;
 
+	Bitmap::MemoryScope memory_scope(Bitmap::MemoryWindow);
 	BitmapRef bitmap = Bitmap::Create(width, height, false);
 
 	if (stretch) {
@@ -211,6 +212,7 @@ void Window::RefreshBackground() {
 void Window::RefreshFrame() {
 	frame_needs_refresh = false;
 
+	Bitmap::MemoryScope memory_scope(Bitmap::MemoryWindow);
 	BitmapRef up_bitmap = Bitmap::Create(width, 8);
 	BitmapRef down_bitmap = Bitmap::Create(width, 8);
 
@@ -281,6 +283,7 @@ void Window::RefreshCursor() {
 	int cw = cursor_rect.width;
 	int ch = cursor_rect.height;
 
+	Bitmap::MemoryScope memory_scope(Bitmap::MemoryWindow);
 	BitmapRef cursor1_bitmap = Bitmap::Create(cw, ch);
 	BitmapRef cursor2_bitmap = Bitmap::Create(cw, ch);
 
@@ -363,6 +366,9 @@ BitmapRef Window::GetContents() const {
 }
 void Window::SetContents(BitmapRef const& ncontents) {
 	contents = ncontents;
+	if (contents) {
+		contents->SetMemoryCategory(Bitmap::MemoryWindow);
+	}
 }
 
 bool Window::GetStretch() const {
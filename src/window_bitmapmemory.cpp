@@ -0,0 +1,71 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include <sstream>
+#include "window_bitmapmemory.h"
+#include "bitmap.h"
+
+Window_BitmapMemory::Window_BitmapMemory(int ix, int iy, int iwidth, int iheight) :
+	Window_Base(ix, iy, iwidth, iheight) {
+
+	SetContents(Bitmap::Create(width - 16, height - 16));
+	contents->SetTransparentColor(windowskin->GetTransparentColor());
+}
+
+void Window_BitmapMemory::Refresh() {
+	contents->Clear();
+
+	// Right edges of the live KB, peak KB and bitmap count columns
+	int const live_x = contents->GetWidth() - 80;
+	int const peak_x = contents->GetWidth() - 36;
+	int const count_x = contents->GetWidth();
+
+	contents->TextDraw(live_x, 2, Font::ColorDisabled, "Live KB", Text::AlignRight);
+	contents->TextDraw(peak_x, 2, Font::ColorDisabled, "Peak", Text::AlignRight);
+	contents->TextDraw(count_x, 2, Font::ColorDisabled, "Count", Text::AlignRight);
+
+	Bitmap::MemoryStats total;
+	std::stringstream ss;
+	for (int i = 0; i <= Bitmap::MemoryCategoryCount; ++i) {
+		Bitmap::MemoryStats stats;
+		int y = 16 * (i + 1) + 2;
+		if (i < Bitmap::MemoryCategoryCount) {
+			stats = Bitmap::GetMemoryStats((Bitmap::MemoryCategory)i);
+			contents->TextDraw(0, y, Font::ColorDefault, Bitmap::GetMemoryCategoryName((Bitmap::MemoryCategory)i));
+
+			total.live_bytes += stats.live_bytes;
+			total.live_count += stats.live_count;
+		} else {
+			// Peaks of the categories were not reached at the same time
+			stats = total;
+			contents->TextDraw(0, y, Font::ColorDisabled, "Total");
+		}
+
+		ss.str("");
+		ss << stats.live_bytes / 1024;
+		contents->TextDraw(live_x, y, Font::ColorDefault, ss.str(), Text::AlignRight);
+		if (i < Bitmap::MemoryCategoryCount) {
+			ss.str("");
+			ss << stats.peak_bytes / 1024;
+			contents->TextDraw(peak_x, y, Font::ColorDefault, ss.str(), Text::AlignRight);
+		}
+		ss.str("");
+		ss << stats.live_count;
+		contents->TextDraw(count_x, y, Font::ColorDefault, ss.str(), Text::AlignRight);
+	}
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include <iomanip>
+#include <sstream>
+#include "window_eventprofile.h"
+#include "interpreter_profiler.h"
+#include "bitmap.h"
+
+Window_EventProfile::Window_EventProfile(int ix, int iy, int iwidth, int iheight) :
+	Window_Base(ix, iy, iwidth, iheight), show_commands(false) {
+
+	SetContents(Bitmap::Create(width - 16, height - 16));
+	contents->SetTransparentColor(windowskin->GetTransparentColor());
+}
+
+void Window_EventProfile::Refresh() {
+	contents->Clear();
+
+	std::vector<InterpreterProfiler::Entry> entries = show_commands ?
+		InterpreterProfiler::GetCommands() : InterpreterProfiler::GetEvents();
+
+	int rows = (contents->GetHeight() - 4) / 16;
+	std::stringstream ss;
+	for (int i = 0; i < rows && i < (int)entries.size(); ++i) {
+		const InterpreterProfiler::Entry& entry = entries[i];
+
+		ss.str("");
+		ss << std::setfill('0');
+		if (show_commands) {
+			ss << entry.code;
+		} else if (entry.common_event_id > 0) {
+			ss << "CE" << std::setw(4) << entry.common_event_id;
+		} else {
+			ss << "M" << std::setw(4) << entry.map_id << ":EV" << std::setw(4) << entry.event_id;
+		}
+		ss << " x" << entry.executions;
+		contents->TextDraw(0, 16 * i + 2, Font::ColorDefault, ss.str());
+
+		// Events which hit the execution limit are highlighted
+		ss.str("");
+		ss << std::setfill(' ') << std::fixed << std::setprecision(1) << entry.time_ns / 1000000.0 << "ms";
+		contents->TextDraw(contents->GetWidth(), 16 * i + 2,
+			entry.limit_frames > 0 ? Font::ColorCritical : Font::ColorDefault, ss.str(), Text::AlignRight);
+	}
+}
+
+void Window_EventProfile::SetShowCommands(bool show) {
+	show_commands = show;
+	Refresh();
+}
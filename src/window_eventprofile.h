@@ -0,0 +1,51 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WINDOW_EVENTPROFILE_H_
+#define _WINDOW_EVENTPROFILE_H_
+
+// Headers
+#include "window_base.h"
+
+/**
+ * Window_EventProfile class.
+ * Lists the events or event commands that took the most time.
+ */
+class Window_EventProfile : public Window_Base {
+public:
+	/**
+	 * Constructor.
+	 */
+	Window_EventProfile(int ix, int iy, int iwidth, int iheight);
+
+	/**
+	 * Renders the current interpreter profile.
+	 */
+	void Refresh();
+
+	/**
+	 * Sets whether command codes or events are listed.
+	 *
+	 * @param show_commands true to list command codes.
+	 */
+	void SetShowCommands(bool show_commands);
+
+private:
+	bool show_commands;
+};
+
+#endif
@@ -651,8 +651,7 @@ void Window_Message::InputChoice() {
 void Window_Message::InputNumber() {
 	if (Input::IsTriggered(Input::DECISION)) {
 		Game_System::SePlay(Main_Data::game_data.system.decision_se);
-		Game_Variables[Game_Message::num_input_variable_id] = number_input_window->GetNumber();
-		Game_Map::SetNeedRefresh(true);
+		Game_Variables.Set(Game_Message::num_input_variable_id, number_input_window->GetNumber());
 		TerminateMessage();
 		number_input_window->SetNumber(0);
 	}
@@ -0,0 +1,83 @@
+#include <cassert>
+#include <cstdlib>
+#include "change_journal.h"
+
+static void DirtyIds() {
+	ChangeJournal<int> changes;
+	assert(!changes.IsChanged(3));
+	assert(!changes.IsChanged(-1));
+
+	changes.Record(3, 0, 1, 0);
+	changes.Record(10, 0, 5, 0);
+	changes.Record(3, 1, 2, 1);
+	assert(changes.IsChanged(3));
+	assert(changes.IsChanged(10));
+	assert(!changes.IsChanged(4));
+	assert(!changes.IsChanged(11));
+
+	// Each ID once, in order of the first change
+	assert(changes.GetChanged().size() == 2);
+	assert(changes.GetChanged()[0] == 3);
+	assert(changes.GetChanged()[1] == 10);
+
+	changes.ClearChanged();
+	assert(changes.GetChanged().empty());
+	assert(!changes.IsChanged(3));
+	assert(!changes.IsChanged(10));
+
+	changes.Record(10, 5, 6, 2);
+	assert(changes.GetChanged().size() == 1);
+	assert(changes.IsChanged(10));
+	assert(!changes.IsChanged(3));
+}
+
+static void JournalDisabled() {
+	ChangeJournal<bool> changes;
+	changes.Record(1, false, true, 0);
+	assert(changes.GetJournal().empty());
+	assert(changes.IsChanged(1));
+}
+
+static void JournalTrimming() {
+	ChangeJournal<int> changes;
+	changes.SetJournalSize(3);
+	for (int i = 1; i <= 5; ++i) {
+		changes.Record(i, i - 1, i, i * 10);
+	}
+
+	// Oldest entries are dropped first
+	assert(changes.GetJournal().size() == 3);
+	assert(changes.GetJournal().front().id == 3);
+	assert(changes.GetJournal().front().old_value == 2);
+	assert(changes.GetJournal().front().new_value == 3);
+	assert(changes.GetJournal().front().frame == 30);
+	assert(changes.GetJournal().back().id == 5);
+
+	// Clearing the changed IDs keeps the journal
+	changes.ClearChanged();
+	assert(changes.GetJournal().size() == 3);
+
+	changes.SetJournalSize(2);
+	assert(changes.GetJournal().size() == 2);
+	assert(changes.GetJournal().front().id == 4);
+
+	changes.SetJournalSize(0);
+	assert(changes.GetJournal().empty());
+	changes.Record(7, 0, 1, 70);
+	assert(changes.GetJournal().empty());
+
+	changes.SetJournalSize(2);
+	changes.Record(7, 1, 2, 80);
+	changes.Clear();
+	assert(changes.GetJournal().empty());
+	assert(changes.GetChanged().empty());
+	assert(!changes.IsChanged(7));
+}
+
+extern "C" int main(int, char**) {
+	DirtyIds();
+	JournalDisabled();
+	JournalTrimming();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+#include <cassert>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "command_codes.h"
+#include "jump_table.h"
+
+namespace {
+	typedef std::vector<RPG::EventCommand> List;
+
+	// The linear scans of the interpreter before jump tables
+
+	bool LinearSkipTo(const List& list, int& index, int code, int code2, int min_indent, int max_indent, bool otherwise_end) {
+		int idx;
+		for (idx = index; (size_t) idx < list.size(); idx++) {
+			if (list[idx].indent < min_indent)
+				return false;
+			if (list[idx].indent > max_indent)
+				continue;
+			if (list[idx].code != code &&
+				list[idx].code != code2)
+				continue;
+			index = idx;
+			return true;
+		}
+
+		if (otherwise_end)
+			index = idx;
+
+		return true;
+	}
+
+	bool LinearEndLoop(const List& list, int& index) {
+		int indent = list[index].indent;
+
+		for (int idx = index; idx >= 0; idx--) {
+			if (list[idx].indent > indent)
+				continue;
+			if (list[idx].indent < indent)
+				return false;
+			if (list[idx].code != Cmd::Loop)
+				continue;
+			index = idx;
+			break;
+		}
+
+		return true;
+	}
+
+	int LinearJumpToLabel(const List& list, int label_id) {
+		for (int idx = 0; (size_t) idx < list.size(); idx++) {
+			if (list[idx].code != Cmd::Label)
+				continue;
+			if (list[idx].parameters[0] != label_id)
+				continue;
+			return idx;
+		}
+		return -1;
+	}
+
+	const int codes[] = {
+		Cmd::ShowMessage, Cmd::ConditionalBranch, Cmd::ElseBranch, Cmd::EndBranch,
+		Cmd::ShowChoiceOption, Cmd::ShowChoiceEnd, Cmd::Label, Cmd::JumpToLabel,
+		Cmd::Loop, Cmd::BreakLoop, Cmd::EndLoop
+	};
+	const int code_count = sizeof(codes) / sizeof(codes[0]);
+
+	/** Commands with random codes, the indent changes by one level at most. */
+	List RandomList(int size) {
+		List list(size);
+		int indent = 0;
+		for (int i = 0; i < size; ++i) {
+			list[i].code = codes[rand() % code_count];
+			list[i].indent = indent;
+			if (list[i].code == Cmd::Label) {
+				list[i].parameters.push_back(rand() % 4 + 1);
+			}
+			indent = std::max(0, indent + rand() % 3 - 1);
+		}
+		return list;
+	}
+
+	void CheckSkipTo(const List& list, const JumpTable& table, int index,
+		int code, int code2, int min_indent, int max_indent, bool otherwise_end) {
+		int linear_index = index;
+		int table_index = index;
+		bool const linear = LinearSkipTo(list, linear_index, code, code2, min_indent, max_indent, otherwise_end);
+		bool const jumped = table.SkipTo(table_index, code, code2, min_indent, max_indent, otherwise_end);
+		assert(linear == jumped);
+		assert(linear_index == table_index);
+	}
+
+	void CheckList(const List& list) {
+		JumpTableRef table = JumpTable::Create(list);
+
+		for (int index = 0; index < (int)list.size(); ++index) {
+			int const indent = list[index].indent;
+
+			for (int c = 0; c < code_count; ++c) {
+				// Default indents of Game_Interpreter::SkipTo
+				CheckSkipTo(list, *table, index, codes[c], codes[c], indent, indent, false);
+				CheckSkipTo(list, *table, index, codes[c], Cmd::EndBranch, indent, indent, true);
+			}
+			// BreakLoop
+			CheckSkipTo(list, *table, index, Cmd::EndLoop, Cmd::EndLoop, 0, indent - 1, true);
+
+			int linear_index = index;
+			int table_index = index;
+			bool const linear = LinearEndLoop(list, linear_index);
+			assert(linear == table->FindLoop(table_index));
+			assert(linear_index == table_index);
+		}
+
+		for (int label_id = 0; label_id <= 5; ++label_id) {
+			assert(LinearJumpToLabel(list, label_id) == table->FindLabel(label_id));
+		}
+	}
+
+	void RandomLists() {
+		srand(1);
+		for (int i = 0; i < 2000; ++i) {
+			CheckList(RandomList(rand() % 40));
+		}
+	}
+
+	void SharedTables() {
+		List first = RandomList(10);
+		List second = first;
+
+		JumpTableRef table = JumpTable::Get(first);
+		assert(JumpTable::Get(first) == table);
+		assert(JumpTable::Get(second) != table);
+
+		JumpTable::ClearCache();
+		assert(JumpTable::Get(first) != table);
+	}
+}
+
+extern "C" int main(int, char**) {
+	RandomLists();
+	SharedTables();
+
+	return EXIT_SUCCESS;
+}